@@ -0,0 +1,95 @@
+// Randomized check of incremental culling.
+// Grows a tree, then repeatedly drops random obstacles, culls and regrows. After each cull the tree must hold exactly
+// the nodes whose whole path to the root is still collision-free, as found by checking every edge.
+//
+// Usage: nanotree_cull_check [num_seeds]
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "config.h"
+#include "core/problem.h"
+#include "core/rng.h"
+#include "planner/tree.h"
+
+static constexpr int NUM_EDITS = 40;
+static constexpr int NUM_OBSTACLES_PER_EDIT_MAX = 3;
+static constexpr int NUM_INITIAL_SAMPLES = 3000;
+static constexpr int NUM_REGROW_SAMPLES = 200;
+
+// Nodes reachable from the root over collision-free edges only.
+std::vector<bool> findReachable(const Tree& tree, const ObstacleGrid& obstacle_grid) {
+    std::vector<bool> is_reachable(tree.pool.capacity(), false);
+    if (collides(tree.pool.pos[tree.root()], obstacle_grid)) {
+        is_reachable[tree.root()] = true;
+        return is_reachable;
+    }
+    SubtreeWalker walker;
+    walker.preorder(tree.pool, tree.root(), [&](const NodeId node) {
+        if (tree.pool.hasParent(node) && edgeCollides(tree.pool, node, obstacle_grid)) {
+            return false;
+        }
+        is_reachable[node] = true;
+        return true;
+    });
+    return is_reachable;
+}
+
+// Number of nodes kept that should have been culled, plus nodes culled that should have been kept.
+int countMismatches(const Tree& tree, const std::vector<bool>& is_reachable) {
+    std::vector<bool> is_kept(tree.pool.capacity(), false);
+    for (const NodeId node : tree.nodes) {
+        is_kept[node] = true;
+    }
+    int num_mismatches = 0;
+    for (std::size_t node = 0; node < is_reachable.size(); ++node) {
+        num_mismatches += (is_reachable[node] != is_kept[node]) ? 1 : 0;
+    }
+    return num_mismatches;
+}
+
+int runSeed(const std::uint64_t seed) {
+    Problem problem = makeProblem(DEFAULT_OBSTACLES, DEFAULT_START, DEFAULT_GOAL);
+    const Rng rng = makeRng(seed);
+
+    Tree tree;
+    tree.reset(problem);
+    tree.grow(problem, NUM_INITIAL_SAMPLES, true, ConnectionMode::FIXED_RADIUS, true, false, rng.fork(0));
+
+    int num_failures = 0;
+    for (int edit = 0; edit < NUM_EDITS; ++edit) {
+        Rng edit_rng = rng.fork(1 + edit);
+        Obstacles added_obstacles;
+        const int num_obstacles = 1 + static_cast<int>(edit_rng.uniformIndex(NUM_OBSTACLES_PER_EDIT_MAX));
+        for (int i = 0; i < num_obstacles; ++i) {
+            const Obstacle obstacle = {edit_rng.uniform(ENVIRONMENT_X_MIN, ENVIRONMENT_X_MAX), edit_rng.uniform(ENVIRONMENT_Y_MIN, ENVIRONMENT_Y_MAX)};
+            problem.addObstacle(obstacle);
+            added_obstacles.push_back(obstacle);
+        }
+
+        // The reference is taken on the pre-cull tree, whose node handles cull keeps valid.
+        const std::vector<bool> is_reachable = findReachable(tree, problem.obstacle_grid);
+        tree.cullByObstacles(added_obstacles, problem.obstacle_grid);
+        const int num_mismatches = countMismatches(tree, is_reachable);
+        if (num_mismatches > 0) {
+            std::printf("seed %llu edit %d: %d nodes culled wrongly\n", static_cast<unsigned long long>(seed), edit, num_mismatches);
+            num_failures++;
+        }
+
+        // Regrow with rewiring so later culls see edge grid entries left stale by rewires.
+        tree.grow(problem, NUM_REGROW_SAMPLES, true, ConnectionMode::FIXED_RADIUS, true, false, edit_rng.fork(RngPurpose::SAMPLE));
+    }
+    return num_failures;
+}
+
+int main(int argc, char** argv) {
+    const int num_seeds = (argc > 1) ? std::max(std::atoi(argv[1]), 1) : 10;
+
+    int num_failures = 0;
+    for (int seed = 0; seed < num_seeds; ++seed) {
+        num_failures += runSeed(seed);
+    }
+    std::printf("%d seeds x %d edits, %d failures\n", num_seeds, NUM_EDITS, num_failures);
+    return (num_failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,118 @@
+// Headless planner benchmark.
+// Runs each scenario for a fixed number of frames and reports mean per-phase timings and the final path cost.
+//
+// Usage: nanotree_bench [num_frames] [seed]
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "config.h"
+#include "core/clock.h"
+#include "core/problem.h"
+#include "planner/planner.h"
+
+struct Scenario {
+    const char* name;
+    Obstacles obstacles;
+    int num_samples;
+    int num_carry;
+    CarryPolicy carry_policy;
+    ConnectionMode connection_mode;
+    bool move_start;
+    bool add_obstacles;
+    bool rrtx;
+};
+
+struct ScenarioResult {
+    double grow_ms = 0.0;
+    double carry_ms = 0.0;
+    double cull_ms = 0.0;
+    double plan_ms = 0.0;
+    int num_nodes = 0;
+    float mean_neighbors = 0.0f;
+    float path_cost = 0.0f;
+    bool goal_reached = false;
+};
+
+std::vector<Scenario> makeScenarios() {
+    return {
+        {"maze", DEFAULT_OBSTACLES, 500, 2000, CarryPolicy::UNIFORM, ConnectionMode::FIXED_RADIUS, false, false, false},
+        {"maze-large", DEFAULT_OBSTACLES, 2000, 20000, CarryPolicy::UNIFORM, ConnectionMode::FIXED_RADIUS, false, false, false},
+        {"large-shrink", DEFAULT_OBSTACLES, 2000, 20000, CarryPolicy::UNIFORM, ConnectionMode::SHRINKING_RADIUS, false, false, false},
+        {"large-knn", DEFAULT_OBSTACLES, 2000, 20000, CarryPolicy::UNIFORM, ConnectionMode::K_NEAREST, false, false, false},
+        {"open", {}, 500, 2000, CarryPolicy::UNIFORM, ConnectionMode::FIXED_RADIUS, false, false, false},
+        {"maze-cover", DEFAULT_OBSTACLES, 500, 500, CarryPolicy::COVERAGE, ConnectionMode::FIXED_RADIUS, false, false, false},
+        {"maze-replan", DEFAULT_OBSTACLES, 500, 2000, CarryPolicy::UNIFORM, ConnectionMode::FIXED_RADIUS, true, true, false},
+        {"rrtx-replan", DEFAULT_OBSTACLES, 500, 2000, CarryPolicy::UNIFORM, ConnectionMode::FIXED_RADIUS, true, true, true},
+    };
+}
+
+ScenarioResult runScenario(const Scenario& scenario, const int num_frames, const unsigned int seed) {
+    Problem problem = makeProblem(scenario.obstacles, DEFAULT_START, DEFAULT_GOAL);
+    const PlanSettings plan_settings = {scenario.num_carry, scenario.carry_policy, scenario.num_samples, true, scenario.connection_mode, true, false, true, scenario.rrtx};
+
+    Planner planner;
+    planner.seed = seed;
+    planner.prep(problem, plan_settings);
+
+    ScenarioResult result;
+    for (int frame = 0; frame < num_frames; ++frame) {
+        // Sweep the start back and forth within its room, and every few frames
+        // drop an obstacle into the corridor between the start and goal rooms.
+        bool start_changed = false;
+        if (scenario.move_start) {
+            const int phase = frame % 100;
+            problem.start.x = DEFAULT_START.x + 1.2f * static_cast<float>((phase < 50) ? phase : (100 - phase));
+            start_changed = true;
+        }
+
+        bool obstacle_added = false;
+        Obstacles added_obstacles;
+        if (scenario.add_obstacles && ((frame % 10) == 0)) {
+            const Vector2 obstacle = {0.5f * (DEFAULT_START.x + DEFAULT_GOAL.x), DEFAULT_GOAL.y - 120.0f + static_cast<float>((frame / 10) % 20) * OBSTACLE_SPACING_MIN};
+            if (!problem.obstacle_grid.anyWithin(obstacle, OBSTACLE_SPACING_MIN)) {
+                problem.addObstacle(obstacle);
+                added_obstacles.push_back(obstacle);
+                obstacle_added = true;
+            }
+        }
+
+        const ProblemEdits problem_edits = {start_changed, false, obstacle_added, false, added_obstacles, {}};
+        const TreeEdits tree_edits = {false, true};
+        const ActionSettings action_settings = {problem_edits, tree_edits};
+
+        const double plan_start = getTime();
+        planner.plan(problem, plan_settings, action_settings);
+        result.plan_ms += 1000.0 * (getTime() - plan_start);
+
+        result.grow_ms += 1000.0 * planner.timing.grow.history.back().duration;
+        result.carry_ms += 1000.0 * planner.timing.carry.history.back().duration;
+        result.cull_ms += 1000.0 * planner.timing.cull.history.back().duration;
+    }
+
+    result.grow_ms /= num_frames;
+    result.carry_ms /= num_frames;
+    result.cull_ms /= num_frames;
+    result.plan_ms /= num_frames;
+
+    const NodePool& pool = planner.pool();
+    const Vector2 path_target = planner.pathTarget(problem);
+    result.num_nodes = static_cast<int>(planner.nodes().size());
+    result.mean_neighbors = planner.meanNeighborhoodSize();
+    result.path_cost = pool.estimateCostTo(planner.path.back(), path_target);
+    result.goal_reached = goalReached(pool, planner.path, path_target);
+    return result;
+}
+
+int main(int argc, char** argv) {
+    const int num_frames = (argc > 1) ? std::max(std::atoi(argv[1]), 1) : 200;
+    const unsigned int seed = (argc > 2) ? static_cast<unsigned int>(std::atoi(argv[2])) : 0;
+
+    std::printf("%-12s %8s %8s %10s %10s %10s %10s %8s %10s %10s\n", "scenario", "samples", "carry", "grow_ms", "carry_ms", "cull_ms", "plan_ms", "nodes", "neighbors", "path_cost");
+    for (const Scenario& scenario : makeScenarios()) {
+        const ScenarioResult result = runScenario(scenario, num_frames, seed);
+        std::printf("%-12s %8d %8d %10.3f %10.3f %10.3f %10.3f %8d %10.1f %10.1f%s\n", scenario.name, scenario.num_samples, scenario.num_carry, result.grow_ms, result.carry_ms, result.cull_ms, result.plan_ms, result.num_nodes, result.mean_neighbors, result.path_cost, result.goal_reached ? "" : " (goal missed)");
+    }
+    return 0;
+}
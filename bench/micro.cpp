@@ -0,0 +1,316 @@
+// Micro-benchmarks for the planner hot paths.
+//
+// Benchmarks are parameterised by node count and obstacle count.
+// An obstacle count of -1 selects DEFAULT_OBSTACLES; other counts are uniform random layouts.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "config.h"
+#include "core/obstacle.h"
+#include "core/problem.h"
+#include "core/rng.h"
+#include "planner/informed_set.h"
+#include "planner/sampling.h"
+#include "planner/tree.h"
+
+static constexpr int DEFAULT_LAYOUT = -1;
+static constexpr unsigned int FIXTURE_SEED = 0;
+
+Vector2 randomPos(std::mt19937& gen) {
+    std::uniform_real_distribution<float> dist_x(ENVIRONMENT_X_MIN, ENVIRONMENT_X_MAX);
+    std::uniform_real_distribution<float> dist_y(ENVIRONMENT_Y_MIN, ENVIRONMENT_Y_MAX);
+    return {dist_x(gen), dist_y(gen)};
+}
+
+Obstacles makeObstacles(const int num_obstacles) {
+    if (num_obstacles == DEFAULT_LAYOUT) {
+        return DEFAULT_OBSTACLES;
+    }
+
+    std::mt19937 gen(FIXTURE_SEED);
+    Obstacles obstacles(num_obstacles);
+    for (Obstacle& obstacle : obstacles) {
+        obstacle = randomPos(gen);
+    }
+    return obstacles;
+}
+
+// Synthetic tree of uniformly scattered nodes, built in linear time.
+// Nodes are attached in order of distance from the root, each to the cheapest of the most recent nodes in its own and neighboring grid cells.
+Tree makeTree(const int num_nodes, const Problem& problem) {
+    std::mt19937 gen(FIXTURE_SEED);
+    std::vector<Vector2> positions(num_nodes - 1);
+    for (Vector2& pos : positions) {
+        pos = randomPos(gen);
+    }
+    std::sort(positions.begin(), positions.end(), [&](const Vector2 a, const Vector2 b) { return Vector2DistanceSqr(a, problem.start) < Vector2DistanceSqr(b, problem.start); });
+
+    Tree tree;
+    tree.reset(problem);
+
+    std::vector<NodeId> last_in_cell(NodeGrid::NUM_COLS * NodeGrid::NUM_ROWS, NULL_NODE);
+    last_in_cell[NodeGrid::rowOf(problem.start.y) * NodeGrid::NUM_COLS + NodeGrid::colOf(problem.start.x)] = tree.root();
+
+    for (const Vector2 pos : positions) {
+        const int col = NodeGrid::colOf(pos.x);
+        const int row = NodeGrid::rowOf(pos.y);
+
+        // The straight edge from the root is never beaten, so the root is only the fallback for a node with no candidate.
+        NodeId parent = tree.root();
+        float parent_cost = std::numeric_limits<float>::infinity();
+        for (int r = std::max(row - 1, 0); r <= std::min(row + 1, NodeGrid::NUM_ROWS - 1); ++r) {
+            for (int c = std::max(col - 1, 0); c <= std::min(col + 1, NodeGrid::NUM_COLS - 1); ++c) {
+                const NodeId candidate = last_in_cell[r * NodeGrid::NUM_COLS + c];
+                if ((candidate != NULL_NODE) && (tree.pool.estimateCostTo(candidate, pos) < parent_cost)) {
+                    parent = candidate;
+                    parent_cost = tree.pool.estimateCostTo(candidate, pos);
+                }
+            }
+        }
+
+        const NodeId node = tree.addNode(pos, tree.pool.estimateCostTo(parent, pos), parent);
+        tree.nodes.push_back(node);
+        last_in_cell[row * NodeGrid::NUM_COLS + col] = node;
+    }
+
+    tree.grid.build(tree.pool, tree.nodes);
+    tree.edge_grid.build(tree.pool, tree.nodes);
+    tree.updateGoalRegion(problem.goal, problem.obstacle_grid);
+    return tree;
+}
+
+struct Fixture {
+    Problem problem;
+    Tree tree;
+    Path path;
+};
+
+// Fixtures are expensive to build at the top node counts, so each one is built once and shared.
+const Fixture& getFixture(const int num_nodes, const int num_obstacles) {
+    static std::map<std::pair<int, int>, Fixture> fixtures;
+    const std::pair<int, int> key = {num_nodes, num_obstacles};
+    auto it = fixtures.find(key);
+    if (it == fixtures.end()) {
+        Fixture fixture;
+        fixture.problem = makeProblem(makeObstacles(num_obstacles), DEFAULT_START, DEFAULT_GOAL);
+        fixture.tree = makeTree(num_nodes, fixture.problem);
+        fixture.path = extractPath(fixture.tree.pool, fixture.tree.pathEnd());
+        it = fixtures.emplace(key, std::move(fixture)).first;
+    }
+    return it->second;
+}
+
+const Problem& getProblem(const int num_obstacles) {
+    return getFixture(1, num_obstacles).problem;
+}
+
+std::vector<Vector2> makeQueries(const int num_queries) {
+    std::mt19937 gen(FIXTURE_SEED + 1);
+    std::vector<Vector2> queries(num_queries);
+    for (Vector2& query : queries) {
+        query = randomPos(gen);
+    }
+    return queries;
+}
+
+static const std::vector<Vector2> QUERIES = makeQueries(1 << 12);
+
+Vector2 getQuery(const std::size_t i) {
+    return QUERIES[i % QUERIES.size()];
+}
+
+// Segments of the maximum steering length in random directions.
+Vector2 getSegmentEnd(const std::size_t i) {
+    const Vector2 start = getQuery(i);
+    const Vector2 toward = getQuery(i + 1);
+    return start + Vector2Normalize(toward - start) * DEVIATION_DISTANCE_MAX;
+}
+
+void BM_EdgeCollides(benchmark::State& state) {
+    const Problem& problem = getProblem(state.range(0));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(edgeCollides(getQuery(i), getSegmentEnd(i), problem.obstacle_grid));
+        i++;
+    }
+}
+
+void BM_Collides(benchmark::State& state) {
+    const Problem& problem = getProblem(state.range(0));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(collides(getQuery(i), problem.obstacle_grid));
+        i++;
+    }
+}
+
+// One brush step of obstacle painting: add an obstacle, then erase it again, keeping the distance field in sync.
+void BM_AddRemoveObstacle(benchmark::State& state) {
+    Problem problem = getProblem(state.range(0));
+    Obstacles removed_obstacles;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const Vector2 pos = getQuery(i);
+        problem.addObstacle(pos);
+        removed_obstacles.clear();
+        // A tiny radius removes only the obstacle just added, so the layout stays the same across iterations.
+        benchmark::DoNotOptimize(problem.removeObstaclesWithin(pos, 1e-3f, removed_obstacles));
+        i++;
+    }
+}
+
+void BM_GetNeighbors(benchmark::State& state) {
+    const Fixture& fixture = getFixture(state.range(0), state.range(1));
+    const ConnectionRange range = computeConnectionRange(static_cast<ConnectionMode>(state.range(2)), fixture.tree.nodes.size());
+    Neighborhood neighborhood;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        queryNeighborhood(getQuery(i), fixture.tree.grid, range, neighborhood);
+        benchmark::DoNotOptimize(neighborhood.data());
+        i++;
+    }
+}
+
+void BM_GetParent(benchmark::State& state) {
+    const Fixture& fixture = getFixture(state.range(0), state.range(1));
+    Neighborhood neighborhood;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const Vector2 query = getQuery(i);
+        queryNeighborhood(query, fixture.tree.grid, REWIRE_RADIUS, neighborhood);
+        benchmark::DoNotOptimize(getParent(query, fixture.tree.pool, fixture.tree.grid, fixture.problem.obstacle_grid, neighborhood));
+        i++;
+    }
+}
+
+void BM_GrowOnce(benchmark::State& state) {
+    const Fixture& fixture = getFixture(state.range(0), state.range(1));
+    const ConnectionMode connection_mode = static_cast<ConnectionMode>(state.range(2));
+    Tree tree = fixture.tree;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        tree.growOnce(getQuery(i), fixture.problem.obstacle_grid, true, connection_mode);
+        i++;
+    }
+}
+
+void BM_Rewire(benchmark::State& state) {
+    const Fixture& fixture = getFixture(state.range(0), state.range(1));
+    Tree tree = fixture.tree;
+    Neighborhood neighborhood;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const NodeId node = tree.nodes[(i * 7919) % tree.nodes.size()];
+        queryNeighborhood(tree.pool.pos[node], tree.grid, REWIRE_RADIUS, neighborhood);
+        tree.rewire(node, neighborhood, fixture.problem.obstacle_grid);
+        tree.resolveCosts();
+        i++;
+    }
+}
+
+void BM_Carry(benchmark::State& state) {
+    const Fixture& fixture = getFixture(state.range(0), DEFAULT_LAYOUT);
+    const CarryPolicy policy = static_cast<CarryPolicy>(state.range(1));
+    for (auto _ : state) {
+        state.PauseTiming();
+        Tree tree = fixture.tree;
+        state.ResumeTiming();
+        tree.carry(fixture.path, state.range(0) / 2, policy, makeRng(FIXTURE_SEED));
+    }
+}
+
+// Cull after painting one obstacle at a random position.
+void BM_CullByObstacles(benchmark::State& state) {
+    const Fixture& fixture = getFixture(state.range(0), state.range(1));
+    std::size_t i = 0;
+    std::size_t num_culled = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Tree tree = fixture.tree;
+        const Obstacles added_obstacles = {getQuery(i)};
+        state.ResumeTiming();
+        tree.cullByObstacles(added_obstacles, fixture.problem.obstacle_grid);
+        num_culled += fixture.tree.nodes.size() - tree.nodes.size();
+        i++;
+    }
+    state.counters["culled"] = benchmark::Counter(static_cast<double>(num_culled), benchmark::Counter::kAvgIterations);
+}
+
+void BM_ResetRoot(benchmark::State& state) {
+    const Fixture& fixture = getFixture(state.range(0), state.range(1));
+    Problem problem = fixture.problem;
+    problem.start.x += 2.0f * START_CHANGED_DIST_MIN;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Tree tree = fixture.tree;
+        state.ResumeTiming();
+        tree.resetRoot(problem, fixture.path);
+    }
+}
+
+void BM_Reroot(benchmark::State& state) {
+    const Fixture& fixture = getFixture(state.range(0), state.range(1));
+    Problem problem = fixture.problem;
+    problem.start.x += 2.0f * START_CHANGED_DIST_MIN;
+    std::size_t num_nodes = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Tree tree = fixture.tree;
+        state.ResumeTiming();
+        tree.reroot(problem, fixture.path);
+        num_nodes = tree.nodes.size();
+    }
+    state.counters["kept"] = static_cast<double>(num_nodes);
+}
+
+void BM_ExtractPath(benchmark::State& state) {
+    const Fixture& fixture = getFixture(state.range(0), state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(extractPath(fixture.tree.pool, fixture.tree.pathEnd()));
+    }
+}
+
+static const std::vector<int64_t> NODE_COUNTS = {1000, 10000, 100000, 1000000};
+static const std::vector<int64_t> OBSTACLE_COUNTS = {DEFAULT_LAYOUT, 0, 1000, 100000};
+
+void BM_FillSamples(benchmark::State& state) {
+    const int num_samples = static_cast<int>(state.range(0));
+    const Vector2 start = {ENVIRONMENT_X_MIN + 0.25f * ENVIRONMENT_WIDTH, ENVIRONMENT_Y_MIN + 0.5f * ENVIRONMENT_HEIGHT};
+    const Vector2 goal = {ENVIRONMENT_X_MIN + 0.75f * ENVIRONMENT_WIDTH, ENVIRONMENT_Y_MIN + 0.5f * ENVIRONMENT_HEIGHT};
+    const float cost_best = state.range(1) ? 1.2f * Vector2Distance(start, goal) : std::numeric_limits<float>::infinity();
+    const InformedSet informed_set = makeInformedSet(start, goal, cost_best);
+    const Rng rng = makeRng(FIXTURE_SEED);
+    SampleBatch batch;
+    std::uint32_t first_index = 0;
+    for (auto _ : state) {
+        fillSamples(goal, informed_set, rng, first_index, num_samples, batch);
+        benchmark::DoNotOptimize(batch.xs.data());
+        first_index += num_samples;
+    }
+    state.SetItemsProcessed(state.iterations() * num_samples);
+}
+
+BENCHMARK(BM_EdgeCollides)->ArgName("obstacles")->ArgsProduct({OBSTACLE_COUNTS});
+BENCHMARK(BM_Collides)->ArgName("obstacles")->ArgsProduct({OBSTACLE_COUNTS});
+BENCHMARK(BM_AddRemoveObstacle)->ArgName("obstacles")->ArgsProduct({OBSTACLE_COUNTS})->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_GetNeighbors)->ArgNames({"nodes", "obstacles", "connection"})->ArgsProduct({NODE_COUNTS, OBSTACLE_COUNTS, {0, 1, 2}});
+BENCHMARK(BM_GetParent)->ArgNames({"nodes", "obstacles"})->ArgsProduct({NODE_COUNTS, OBSTACLE_COUNTS});
+BENCHMARK(BM_GrowOnce)->ArgNames({"nodes", "obstacles", "connection"})->ArgsProduct({NODE_COUNTS, OBSTACLE_COUNTS, {0, 1, 2}});
+BENCHMARK(BM_Rewire)->ArgNames({"nodes", "obstacles"})->ArgsProduct({NODE_COUNTS, OBSTACLE_COUNTS});
+BENCHMARK(BM_Carry)->ArgNames({"nodes", "policy"})->ArgsProduct({NODE_COUNTS, {0, 1, 2, 3}})->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CullByObstacles)->ArgNames({"nodes", "obstacles"})->ArgsProduct({NODE_COUNTS, OBSTACLE_COUNTS})->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ResetRoot)->ArgNames({"nodes", "obstacles"})->ArgsProduct({NODE_COUNTS, {DEFAULT_LAYOUT}})->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Reroot)->ArgNames({"nodes", "obstacles"})->ArgsProduct({NODE_COUNTS, {DEFAULT_LAYOUT}})->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ExtractPath)->ArgNames({"nodes", "obstacles"})->ArgsProduct({NODE_COUNTS, {DEFAULT_LAYOUT}});
+
+BENCHMARK(BM_FillSamples)->ArgNames({"samples", "informed"})->ArgsProduct({{10000}, {0, 1}})->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -1,8 +1,10 @@
 #pragma once
 
-#include <raylib.h>
-
+#include <algorithm>
 #include <array>
+#include <vector>
+
+#include "core/math.h"
 
 // UI OPTIONS
 static constexpr std::array<int, 10> NUM_SAMPLES_OPTIONS = {0, 1, 10, 100, 200, 500, 1000, 2000, 5000, 10000};
@@ -70,6 +72,7 @@ static constexpr int TEXT_LINE_SPACING_HEIGHT = 32;
 
 static constexpr int BUTTON_ICON_SCALE = 5;
 static constexpr int SMALL_BUTTON_ICON_SCALE = 3;
+static constexpr int TINY_BUTTON_ICON_SCALE = 2;
 static constexpr int VISIBILITY_BUTTON_ICON_SCALE = 3;
 
 // UI TIMES
@@ -81,6 +84,12 @@ static constexpr float TIMING_WINDOW_SEC = 1.0f;
 // PHYSICAL ELEMENTS
 static constexpr float OBSTACLE_RADIUS = 0.8f * CELL_SIZE;
 static constexpr float OBSTACLE_RADIUS_SQR = OBSTACLE_RADIUS * OBSTACLE_RADIUS;
+static constexpr int OBSTACLE_GRID_CELL_SIZE = static_cast<int>(OBSTACLE_RADIUS);
+
+// Obstacle distance field resolution. Collision queries within a cell diagonal of an obstacle boundary fall back to exact tests.
+static constexpr int DISTANCE_FIELD_CELL_SIZE = 4;
+// Clearance beyond this is not stored. Sphere tracing takes steps of up to this length.
+static constexpr float DISTANCE_FIELD_CLEARANCE_MAX = 2.0f * OBSTACLE_RADIUS;
 
 static constexpr float GOAL_RADIUS = CELL_SIZE / 2;
 static constexpr float START_RADIUS = GOAL_RADIUS;
@@ -180,12 +189,44 @@ const std::vector<Vector2> DEFAULT_OBSTACLES = {
 // PLANNER
 static constexpr float GOAL_SAMPLE_PROBABILITY = 0.02;
 
-static constexpr float MAX_DISTANCE_BETWEEN_POSES_FOR_COLLISION_CHECK = 0.5f * OBSTACLE_RADIUS;
-static constexpr int NUM_INTERMEDIATE_COLLISION_CHECK_POINTS = 8;
-static constexpr float DEVIATION_DISTANCE_MAX = NUM_INTERMEDIATE_COLLISION_CHECK_POINTS * MAX_DISTANCE_BETWEEN_POSES_FOR_COLLISION_CHECK;
+// Informed samples that land outside the environment are redrawn up to this many times before falling back to uniform sampling.
+static constexpr int INFORMED_SAMPLE_ATTEMPTS_MAX = 8;
+
+// Edge collision checks are exact, so the steering distance is a free tuning parameter.
+static constexpr float DEVIATION_DISTANCE_MAX = 4.0f * OBSTACLE_RADIUS;
 
 static constexpr float REWIRE_RADIUS = std::min(DEVIATION_DISTANCE_MAX, 1.5f * GOAL_RADIUS);
 
+// The shrinking connection radius is sqrt(CONNECTION_RADIUS_GAMMA_SQR * log(n) / n), capped at REWIRE_RADIUS.
+// RRT* stays asymptotically optimal in the plane for gamma above 2 * sqrt(1.5 * area / pi); this takes the whole environment as the area.
+static constexpr float CONNECTION_RADIUS_GAMMA_SQR = 4.0f * 1.5f * ENVIRONMENT_WIDTH * ENVIRONMENT_HEIGHT / 3.14159265f;
+
+// k-nearest connection links to CONNECTION_K_FACTOR * log(n) nodes, the RRT* bound e * (1 + 1/d) in the plane.
+static constexpr float CONNECTION_K_FACTOR = 1.5f * 2.71828183f;
+
+// Node grid cells match the rewire radius so a neighbor query touches about 3x3 cells.
+static constexpr int NODE_GRID_CELL_SIZE = static_cast<int>(REWIRE_RADIUS);
+
+// Edge grid cells match the obstacle diameter so an added obstacle touches about 2x2 cells.
+static constexpr int EDGE_GRID_CELL_SIZE = static_cast<int>(2.0f * OBSTACLE_RADIUS);
+
 static constexpr float RADIUS_OF_CURVATURE_MIN = 0.99f * std::min(OBSTACLE_RADIUS, 2.0f * GOAL_RADIUS);
 
 static constexpr int NUM_PREP_ITERATIONS = 20;
+
+// Parallel growth proposes at most this many samples per batch, and no more than 1/GROW_BATCH_TREE_FRACTION of the tree size.
+static constexpr int GROW_BATCH_SIZE_MAX = 512;
+static constexpr int GROW_BATCH_TREE_FRACTION = 8;
+
+// The cost carry policy keeps a node with probability (straight-line cost from root to goal / estimated cost through the node)^CARRY_COST_EXPONENT.
+static constexpr float CARRY_COST_EXPONENT = 2.0f;
+
+// The age carry policy keeps nodes that have survived this many carries at full weight, and newer nodes proportionally less.
+static constexpr int CARRY_AGE_SATURATION = 4;
+
+// The RRTX graph links every pair of nodes within this distance. Samples are steered to within it of their nearest node,
+// so every accepted sample has at least one neighbor.
+static constexpr float RRTX_NEIGHBOR_RADIUS = REWIRE_RADIUS;
+
+// The RRTX graph never drops nodes, so it stops growing at this size to bound memory and neighbor counts.
+static constexpr int RRTX_NUM_NODES_MAX = 20000;
@@ -0,0 +1,13 @@
+#pragma once
+
+// How carry weighs the random nodes it keeps beyond the path.
+enum class CarryPolicy {
+    // Every node equally likely.
+    UNIFORM = 0,
+    // Favour nodes with a low estimated cost through them to the goal.
+    COST = 1,
+    // Favour nodes in sparsely populated grid cells.
+    COVERAGE = 2,
+    // Favour nodes that have survived earlier carries.
+    AGE = 3
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <chrono>
+
+// Seconds since the first call, from a monotonic clock.
+inline double getTime() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch).count();
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+
+#include "config.h"
+#include "core/math.h"
+#include "core/obstacle.h"
+
+// Vector width is chosen at build time from the target instruction set.
+// Define NANOTREE_DISABLE_SIMD to force the scalar kernel.
+#if !defined(NANOTREE_DISABLE_SIMD) && defined(__AVX2__)
+#define NANOTREE_SIMD_AVX2
+#include <immintrin.h>
+#elif !defined(NANOTREE_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define NANOTREE_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+// Exact test: an edge collides with an obstacle when the closest point on the segment lies inside the obstacle disk.
+inline bool segmentCollides(const Vector2 start, const Vector2 goal, const Obstacle obstacle) {
+    const Vector2 d = goal - start;
+    const float dd = Vector2DotProduct(d, d);
+    const Vector2 e = obstacle - start;
+    const float t = (dd > 0.0f) ? std::clamp(Vector2DotProduct(e, d) / dd, 0.0f, 1.0f) : 0.0f;
+    return Vector2DistanceSqr(e, d * t) < OBSTACLE_RADIUS_SQR;
+}
+
+// Same test as segmentCollides against a block of obstacle centers stored as separate x and y arrays.
+inline bool segmentCollidesAny(const Vector2 start, const Vector2 goal, const float* xs, const float* ys, const int n) {
+    const float dx = goal.x - start.x;
+    const float dy = goal.y - start.y;
+    const float dd = dx * dx + dy * dy;
+    const float dd_inv = (dd > 0.0f) ? 1.0f / dd : 0.0f;
+
+    int i = 0;
+
+#if defined(NANOTREE_SIMD_AVX2)
+    {
+        const __m256 ax = _mm256_set1_ps(start.x);
+        const __m256 ay = _mm256_set1_ps(start.y);
+        const __m256 vdx = _mm256_set1_ps(dx);
+        const __m256 vdy = _mm256_set1_ps(dy);
+        const __m256 vdd_inv = _mm256_set1_ps(dd_inv);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 r_sqr = _mm256_set1_ps(OBSTACLE_RADIUS_SQR);
+        for (; i + 8 <= n; i += 8) {
+            const __m256 ex = _mm256_sub_ps(_mm256_loadu_ps(xs + i), ax);
+            const __m256 ey = _mm256_sub_ps(_mm256_loadu_ps(ys + i), ay);
+            const __m256 dot = _mm256_add_ps(_mm256_mul_ps(ex, vdx), _mm256_mul_ps(ey, vdy));
+            const __m256 t = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(dot, vdd_inv), zero), one);
+            const __m256 px = _mm256_sub_ps(ex, _mm256_mul_ps(t, vdx));
+            const __m256 py = _mm256_sub_ps(ey, _mm256_mul_ps(t, vdy));
+            const __m256 dist_sqr = _mm256_add_ps(_mm256_mul_ps(px, px), _mm256_mul_ps(py, py));
+            if (_mm256_movemask_ps(_mm256_cmp_ps(dist_sqr, r_sqr, _CMP_LT_OQ)) != 0) {
+                return true;
+            }
+        }
+    }
+#endif
+
+#if defined(NANOTREE_SIMD_AVX2) || defined(NANOTREE_SIMD_SSE)
+    {
+        const __m128 ax = _mm_set1_ps(start.x);
+        const __m128 ay = _mm_set1_ps(start.y);
+        const __m128 vdx = _mm_set1_ps(dx);
+        const __m128 vdy = _mm_set1_ps(dy);
+        const __m128 vdd_inv = _mm_set1_ps(dd_inv);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 r_sqr = _mm_set1_ps(OBSTACLE_RADIUS_SQR);
+        for (; i + 4 <= n; i += 4) {
+            const __m128 ex = _mm_sub_ps(_mm_loadu_ps(xs + i), ax);
+            const __m128 ey = _mm_sub_ps(_mm_loadu_ps(ys + i), ay);
+            const __m128 dot = _mm_add_ps(_mm_mul_ps(ex, vdx), _mm_mul_ps(ey, vdy));
+            const __m128 t = _mm_min_ps(_mm_max_ps(_mm_mul_ps(dot, vdd_inv), zero), one);
+            const __m128 px = _mm_sub_ps(ex, _mm_mul_ps(t, vdx));
+            const __m128 py = _mm_sub_ps(ey, _mm_mul_ps(t, vdy));
+            const __m128 dist_sqr = _mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(py, py));
+            if (_mm_movemask_ps(_mm_cmplt_ps(dist_sqr, r_sqr)) != 0) {
+                return true;
+            }
+        }
+    }
+#endif
+
+    // Scalar tail, or the whole block when no vector kernel is available.
+    for (; i < n; ++i) {
+        const float ex = xs[i] - start.x;
+        const float ey = ys[i] - start.y;
+        const float t = std::clamp((ex * dx + ey * dy) * dd_inv, 0.0f, 1.0f);
+        const float px = ex - t * dx;
+        const float py = ey - t * dy;
+        if (px * px + py * py < OBSTACLE_RADIUS_SQR) {
+            return true;
+        }
+    }
+    return false;
+}
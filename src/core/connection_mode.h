@@ -0,0 +1,11 @@
+#pragma once
+
+// How a new tree node picks the neighbors it may take as parent and rewire.
+enum class ConnectionMode {
+    // Every node within REWIRE_RADIUS.
+    FIXED_RADIUS = 0,
+    // Every node within a radius that shrinks as the tree grows, gamma * sqrt(log(n) / n).
+    SHRINKING_RADIUS = 1,
+    // The k nearest nodes, with k growing as log(n).
+    K_NEAREST = 2
+};
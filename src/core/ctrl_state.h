@@ -1,7 +1,7 @@
 #pragma once
 
-#include <raylib.h>
-
+#include "core/carry_policy.h"
+#include "core/connection_mode.h"
 #include "core/problem_edit_mode.h"
 #include "core/tree_edits.h"
 #include "core/tree_growth_mode.h"
@@ -14,7 +14,13 @@ struct CtrlState {
     TreeGrowthMode tree_growth_mode = TreeGrowthMode::UNTIL_GOAL_REACHED;
     TreeEdits tree_edits = {false, false};
     bool rewire_enabled = true;
+    ConnectionMode connection_mode = ConnectionMode::FIXED_RADIUS;
+    bool parallel_grow_enabled = false;
+    bool informed_sampling_enabled = false;
+    bool reroot_enabled = false;
+    bool rrtx_enabled = false;
     int num_samples_ix = 5;
     int num_carry_ix = 7;
+    CarryPolicy carry_policy = CarryPolicy::UNIFORM;
     Visibility visibility;
 };
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "config.h"
+#include "core/math.h"
+
+// Raster of obstacle clearance over the environment: each cell stores the distance from its center to the nearest
+// obstacle boundary, negative inside an obstacle and capped at DISTANCE_FIELD_CLEARANCE_MAX.
+// A position is never more than CELL_HALF_DIAGONAL from its cell center and clearance is 1-Lipschitz,
+// so a lookup bounds the true clearance to within that margin.
+struct DistanceField {
+    static constexpr int NUM_COLS = (ENVIRONMENT_WIDTH + DISTANCE_FIELD_CELL_SIZE - 1) / DISTANCE_FIELD_CELL_SIZE;
+    static constexpr int NUM_ROWS = (ENVIRONMENT_HEIGHT + DISTANCE_FIELD_CELL_SIZE - 1) / DISTANCE_FIELD_CELL_SIZE;
+    static constexpr float CELL_SIZE_INV = 1.0f / DISTANCE_FIELD_CELL_SIZE;
+    static constexpr float CELL_HALF_DIAGONAL = 0.70710678f * DISTANCE_FIELD_CELL_SIZE;
+    // Absorbs rounding differences between clearance computed by stamping and by nearest-obstacle search.
+    static constexpr float STALE_TOLERANCE = 1e-3f;
+
+    std::vector<float> clearance = std::vector<float>(NUM_COLS * NUM_ROWS, DISTANCE_FIELD_CLEARANCE_MAX);
+
+    static int colOf(const float x) {
+        return std::clamp(static_cast<int>((x - ENVIRONMENT_X_MIN) * CELL_SIZE_INV), 0, NUM_COLS - 1);
+    }
+
+    static int rowOf(const float y) {
+        return std::clamp(static_cast<int>((y - ENVIRONMENT_Y_MIN) * CELL_SIZE_INV), 0, NUM_ROWS - 1);
+    }
+
+    static Vector2 cellCenter(const int row, const int col) {
+        return {ENVIRONMENT_X_MIN + (col + 0.5f) * DISTANCE_FIELD_CELL_SIZE, ENVIRONMENT_Y_MIN + (row + 0.5f) * DISTANCE_FIELD_CELL_SIZE};
+    }
+
+    static bool covers(const Vector2 pos) {
+        return (ENVIRONMENT_X_MIN <= pos.x) && (pos.x <= ENVIRONMENT_X_MAX) && (ENVIRONMENT_Y_MIN <= pos.y) && (pos.y <= ENVIRONMENT_Y_MAX);
+    }
+
+    void clear() {
+        std::fill(clearance.begin(), clearance.end(), DISTANCE_FIELD_CLEARANCE_MAX);
+    }
+
+    // Stored clearance of the cell holding pos. Only meaningful for positions the field covers.
+    float lookup(const Vector2 pos) const {
+        return clearance[rowOf(pos.y) * NUM_COLS + colOf(pos.x)];
+    }
+
+    // Lower the clearance of every cell near a new obstacle. Adding obstacles can only reduce clearance,
+    // so this is exact without looking at any other obstacle.
+    void stamp(const Vector2 obstacle) {
+        const float reach = DISTANCE_FIELD_CLEARANCE_MAX + OBSTACLE_RADIUS;
+        const int col_min = colOf(obstacle.x - reach);
+        const int col_max = colOf(obstacle.x + reach);
+        const int row_min = rowOf(obstacle.y - reach);
+        const int row_max = rowOf(obstacle.y + reach);
+        for (int row = row_min; row <= row_max; ++row) {
+            for (int col = col_min; col <= col_max; ++col) {
+                float& value = clearance[row * NUM_COLS + col];
+                value = std::min(value, Vector2Distance(cellCenter(row, col), obstacle) - OBSTACLE_RADIUS);
+            }
+        }
+    }
+
+    // True if the cell's clearance may have come from an obstacle removed from the disk at pos with radius dist.
+    // A removed obstacle is at least as far from the cell as the disk is, so a cell whose clearance is below its clearance
+    // from the whole disk still has its nearest obstacle and keeps its value.
+    bool isStale(const int row, const int col, const Vector2 pos, const float dist) const {
+        return clearance[row * NUM_COLS + col] >= Vector2Distance(cellCenter(row, col), pos) - dist - OBSTACLE_RADIUS - STALE_TOLERANCE;
+    }
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+// Vector types and math used by the planner.
+// The app defines NANOTREE_USE_RAYLIB so planner state can be handed straight to raylib for drawing.
+// Headless builds get minimal definitions with the same names and semantics.
+#ifdef NANOTREE_USE_RAYLIB
+
+#include <raylib.h>
+#include <raymath.h>
+
+#else
+
+#include <cmath>
+
+struct Vector2 {
+    float x;
+    float y;
+};
+
+struct Rectangle {
+    float x;
+    float y;
+    float width;
+    float height;
+};
+
+inline Vector2 Vector2Add(const Vector2 a, const Vector2 b) {
+    return {a.x + b.x, a.y + b.y};
+}
+
+inline Vector2 Vector2Subtract(const Vector2 a, const Vector2 b) {
+    return {a.x - b.x, a.y - b.y};
+}
+
+inline Vector2 Vector2Scale(const Vector2 v, const float scale) {
+    return {v.x * scale, v.y * scale};
+}
+
+inline float Vector2Length(const Vector2 v) {
+    return std::sqrt(v.x * v.x + v.y * v.y);
+}
+
+inline float Vector2DotProduct(const Vector2 a, const Vector2 b) {
+    return a.x * b.x + a.y * b.y;
+}
+
+inline float Vector2DistanceSqr(const Vector2 a, const Vector2 b) {
+    const float dx = b.x - a.x;
+    const float dy = b.y - a.y;
+    return dx * dx + dy * dy;
+}
+
+inline float Vector2Distance(const Vector2 a, const Vector2 b) {
+    return std::sqrt(Vector2DistanceSqr(a, b));
+}
+
+// Signed angle from a to b.
+inline float Vector2Angle(const Vector2 a, const Vector2 b) {
+    const float dot = a.x * b.x + a.y * b.y;
+    const float det = a.x * b.y - a.y * b.x;
+    return std::atan2(det, dot);
+}
+
+inline Vector2 Vector2Normalize(const Vector2 v) {
+    const float length = Vector2Length(v);
+    return (length > 0.0f) ? Vector2Scale(v, 1.0f / length) : v;
+}
+
+inline Vector2 Vector2Lerp(const Vector2 a, const Vector2 b, const float amount) {
+    return {a.x + amount * (b.x - a.x), a.y + amount * (b.y - a.y)};
+}
+
+inline Vector2 Vector2Rotate(const Vector2 v, const float angle) {
+    const float c = std::cos(angle);
+    const float s = std::sin(angle);
+    return {v.x * c - v.y * s, v.x * s + v.y * c};
+}
+
+inline Vector2 Vector2Clamp(const Vector2 v, const Vector2 min, const Vector2 max) {
+    return {std::fmin(max.x, std::fmax(min.x, v.x)), std::fmin(max.y, std::fmax(min.y, v.y))};
+}
+
+inline Vector2 operator+(const Vector2 a, const Vector2 b) {
+    return Vector2Add(a, b);
+}
+
+inline Vector2 operator-(const Vector2 a, const Vector2 b) {
+    return Vector2Subtract(a, b);
+}
+
+inline Vector2 operator-(const Vector2 v) {
+    return {-v.x, -v.y};
+}
+
+inline Vector2 operator*(const Vector2 v, const float scale) {
+    return Vector2Scale(v, scale);
+}
+
+inline Vector2 operator/(const Vector2 v, const float scale) {
+    return Vector2Scale(v, 1.0f / scale);
+}
+
+#endif
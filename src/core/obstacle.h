@@ -1,12 +1,10 @@
 #pragma once
 
-#include <raylib.h>
-#include <raymath.h>
-
 #include <algorithm>
 #include <vector>
 
 #include "config.h"
+#include "core/math.h"
 
 using Obstacle = Vector2;
 using Obstacles = std::vector<Obstacle>;
@@ -15,6 +13,6 @@ inline bool collides(const Vector2 pos, const Obstacle obstacle) {
     return Vector2DistanceSqr(obstacle, pos) < OBSTACLE_RADIUS_SQR;
 }
 
-inline bool collides(const Vector2 pos, const Obstacles obstacles) {
+inline bool collides(const Vector2 pos, const Obstacles& obstacles) {
     return std::any_of(obstacles.begin(), obstacles.end(), [&pos](auto& obs) { return collides(pos, obs); });
 }
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "config.h"
+#include "core/collision_kernel.h"
+#include "core/distance_field.h"
+#include "core/math.h"
+#include "core/obstacle.h"
+
+// Obstacle centers of one grid cell, stored as separate coordinate arrays for the batch collision kernel.
+struct ObstacleCell {
+    std::vector<float> xs;
+    std::vector<float> ys;
+
+    int size() const {
+        return static_cast<int>(xs.size());
+    }
+
+    Obstacle at(const int i) const {
+        return {xs[i], ys[i]};
+    }
+
+    void clear() {
+        xs.clear();
+        ys.clear();
+    }
+
+    void push_back(const Obstacle obstacle) {
+        xs.push_back(obstacle.x);
+        ys.push_back(obstacle.y);
+    }
+};
+
+// Broadphase for obstacles: uniform bucket grid over the environment with cells sized to the obstacle radius,
+// so point and edge queries only touch obstacles in the cells they overlap.
+// Also keeps the obstacle distance field in sync, which answers most collision queries without visiting any obstacle.
+struct ObstacleGrid {
+    static constexpr int NUM_COLS = (ENVIRONMENT_WIDTH + OBSTACLE_GRID_CELL_SIZE - 1) / OBSTACLE_GRID_CELL_SIZE;
+    static constexpr int NUM_ROWS = (ENVIRONMENT_HEIGHT + OBSTACLE_GRID_CELL_SIZE - 1) / OBSTACLE_GRID_CELL_SIZE;
+    static constexpr float CELL_SIZE_INV = 1.0f / OBSTACLE_GRID_CELL_SIZE;
+
+    std::vector<ObstacleCell> cells = std::vector<ObstacleCell>(NUM_COLS * NUM_ROWS);
+    DistanceField distance_field;
+
+    static int colOf(const float x) {
+        return std::clamp(static_cast<int>((x - ENVIRONMENT_X_MIN) * CELL_SIZE_INV), 0, NUM_COLS - 1);
+    }
+
+    static int rowOf(const float y) {
+        return std::clamp(static_cast<int>((y - ENVIRONMENT_Y_MIN) * CELL_SIZE_INV), 0, NUM_ROWS - 1);
+    }
+
+    void clear() {
+        for (ObstacleCell& cell : cells) {
+            cell.clear();
+        }
+        distance_field.clear();
+    }
+
+    void insert(const Obstacle obstacle) {
+        cells[rowOf(obstacle.y) * NUM_COLS + colOf(obstacle.x)].push_back(obstacle);
+        distance_field.stamp(obstacle);
+    }
+
+    void build(const Obstacles& obstacles) {
+        for (ObstacleCell& cell : cells) {
+            cell.clear();
+        }
+        for (const Obstacle obstacle : obstacles) {
+            cells[rowOf(obstacle.y) * NUM_COLS + colOf(obstacle.x)].push_back(obstacle);
+        }
+        refreshDistanceField(0, DistanceField::NUM_ROWS - 1, 0, DistanceField::NUM_COLS - 1);
+    }
+
+    // Distance from pos to the nearest obstacle center, or max_dist if there is none closer.
+    // Searches rings of cells outward from pos and stops once no unvisited cell can hold a closer obstacle.
+    float nearestDistance(const Vector2 pos, const float max_dist) const {
+        const int col_center = colOf(pos.x);
+        const int row_center = rowOf(pos.y);
+        const int ring_max = static_cast<int>(std::ceil(max_dist * CELL_SIZE_INV));
+
+        float best_dist_sqr = max_dist * max_dist;
+
+        const auto visit_cell = [&](const int row, const int col) {
+            if ((row < 0) || (row >= NUM_ROWS) || (col < 0) || (col >= NUM_COLS)) {
+                return;
+            }
+            const ObstacleCell& cell = cells[row * NUM_COLS + col];
+            for (int i = 0; i < cell.size(); ++i) {
+                const float dx = cell.xs[i] - pos.x;
+                const float dy = cell.ys[i] - pos.y;
+                best_dist_sqr = std::min(best_dist_sqr, dx * dx + dy * dy);
+            }
+        };
+
+        for (int ring = 0; ring <= ring_max; ++ring) {
+            if (ring == 0) {
+                visit_cell(row_center, col_center);
+            } else {
+                for (int col = col_center - ring; col <= col_center + ring; ++col) {
+                    visit_cell(row_center - ring, col);
+                    visit_cell(row_center + ring, col);
+                }
+                for (int row = row_center - ring + 1; row <= row_center + ring - 1; ++row) {
+                    visit_cell(row, col_center - ring);
+                    visit_cell(row, col_center + ring);
+                }
+            }
+
+            // Every cell in the next ring is at least this far from pos.
+            const float ring_dist = ring * OBSTACLE_GRID_CELL_SIZE;
+            if (best_dist_sqr <= ring_dist * ring_dist) {
+                break;
+            }
+        }
+        return std::sqrt(best_dist_sqr);
+    }
+
+    float computeClearance(const Vector2 pos) const {
+        return nearestDistance(pos, DISTANCE_FIELD_CLEARANCE_MAX + OBSTACLE_RADIUS) - OBSTACLE_RADIUS;
+    }
+
+    // Recompute the distance field over a block of its cells from the obstacles.
+    void refreshDistanceField(const int row_min, const int row_max, const int col_min, const int col_max) {
+        for (int row = row_min; row <= row_max; ++row) {
+            for (int col = col_min; col <= col_max; ++col) {
+                distance_field.clearance[row * DistanceField::NUM_COLS + col] = computeClearance(DistanceField::cellCenter(row, col));
+            }
+        }
+    }
+
+    // Update the distance field after the obstacles in a disk were removed from the grid. Only cells whose nearest obstacle
+    // may have been removed are recomputed from the remaining obstacles, so the cost scales with the size of the removed
+    // region rather than the field.
+    void repairDistanceField(const Vector2 pos, const float dist) {
+        static_assert(OBSTACLE_GRID_CELL_SIZE % DISTANCE_FIELD_CELL_SIZE == 0, "Distance field cells must tile obstacle grid cells");
+        static constexpr int FIELD_CELLS_PER_CELL = OBSTACLE_GRID_CELL_SIZE / DISTANCE_FIELD_CELL_SIZE;
+        static constexpr int NUM_CANDIDATES_MAX = 64;
+
+        const float reach = DISTANCE_FIELD_CLEARANCE_MAX + OBSTACLE_RADIUS;
+        const int ring = static_cast<int>(std::ceil(reach * CELL_SIZE_INV));
+        const int field_col_min = DistanceField::colOf(pos.x - dist - reach);
+        const int field_col_max = DistanceField::colOf(pos.x + dist + reach);
+        const int field_row_min = DistanceField::rowOf(pos.y - dist - reach);
+        const int field_row_max = DistanceField::rowOf(pos.y + dist + reach);
+
+        // Stale cells sharing an obstacle grid cell share the obstacles within reach. Where those are few, as in sparse
+        // regions, scan them directly instead of running a ring search per field cell.
+        ObstacleCell candidates;
+        for (int row = field_row_min / FIELD_CELLS_PER_CELL; row <= field_row_max / FIELD_CELLS_PER_CELL; ++row) {
+            for (int col = field_col_min / FIELD_CELLS_PER_CELL; col <= field_col_max / FIELD_CELLS_PER_CELL; ++col) {
+                candidates.clear();
+                bool sparse = true;
+                for (int r = std::max(row - ring, 0); sparse && (r <= std::min(row + ring, NUM_ROWS - 1)); ++r) {
+                    for (int c = std::max(col - ring, 0); sparse && (c <= std::min(col + ring, NUM_COLS - 1)); ++c) {
+                        const ObstacleCell& cell = cells[r * NUM_COLS + c];
+                        for (int i = 0; i < cell.size(); ++i) {
+                            candidates.push_back(cell.at(i));
+                        }
+                        sparse = candidates.size() <= NUM_CANDIDATES_MAX;
+                    }
+                }
+
+                const int block_row_min = std::max(row * FIELD_CELLS_PER_CELL, field_row_min);
+                const int block_row_max = std::min((row + 1) * FIELD_CELLS_PER_CELL - 1, field_row_max);
+                const int block_col_min = std::max(col * FIELD_CELLS_PER_CELL, field_col_min);
+                const int block_col_max = std::min((col + 1) * FIELD_CELLS_PER_CELL - 1, field_col_max);
+                for (int field_row = block_row_min; field_row <= block_row_max; ++field_row) {
+                    for (int field_col = block_col_min; field_col <= block_col_max; ++field_col) {
+                        if (!distance_field.isStale(field_row, field_col, pos, dist)) {
+                            continue;
+                        }
+
+                        const Vector2 center = DistanceField::cellCenter(field_row, field_col);
+                        float clearance = 0.0f;
+                        if (sparse) {
+                            float best_dist_sqr = reach * reach;
+                            for (int i = 0; i < candidates.size(); ++i) {
+                                best_dist_sqr = std::min(best_dist_sqr, Vector2DistanceSqr(candidates.at(i), center));
+                            }
+                            clearance = std::sqrt(best_dist_sqr) - OBSTACLE_RADIUS;
+                        } else {
+                            clearance = computeClearance(center);
+                        }
+                        distance_field.clearance[field_row * DistanceField::NUM_COLS + field_col] = clearance;
+                    }
+                }
+            }
+        }
+    }
+
+    // True if pred holds for any cell overlapping the box [lo, hi].
+    template <typename Predicate>
+    bool anyCellInBox(const Vector2 lo, const Vector2 hi, Predicate&& pred) const {
+        const int col_min = colOf(lo.x);
+        const int col_max = colOf(hi.x);
+        const int row_min = rowOf(lo.y);
+        const int row_max = rowOf(hi.y);
+        for (int row = row_min; row <= row_max; ++row) {
+            for (int col = col_min; col <= col_max; ++col) {
+                const ObstacleCell& cell = cells[row * NUM_COLS + col];
+                if ((cell.size() > 0) && pred(cell)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // True if pred holds for any obstacle whose cell overlaps the box [lo, hi].
+    template <typename Predicate>
+    bool anyInBox(const Vector2 lo, const Vector2 hi, Predicate&& pred) const {
+        return anyCellInBox(lo, hi, [&](const ObstacleCell& cell) {
+            for (int i = 0; i < cell.size(); ++i) {
+                if (pred(cell.at(i))) {
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+
+    bool anyWithin(const Vector2 pos, const float dist) const {
+        const float dist_sqr = dist * dist;
+        const Vector2 delta = {dist, dist};
+        return anyInBox(pos - delta, pos + delta, [&](const Obstacle obstacle) { return Vector2DistanceSqr(obstacle, pos) < dist_sqr; });
+    }
+
+    // Remove all obstacles within dist of pos, returning how many were removed.
+    int removeWithin(const Vector2 pos, const float dist) {
+        const float dist_sqr = dist * dist;
+        const int col_min = colOf(pos.x - dist);
+        const int col_max = colOf(pos.x + dist);
+        const int row_min = rowOf(pos.y - dist);
+        const int row_max = rowOf(pos.y + dist);
+        int num_removed = 0;
+        for (int row = row_min; row <= row_max; ++row) {
+            for (int col = col_min; col <= col_max; ++col) {
+                ObstacleCell& cell = cells[row * NUM_COLS + col];
+                int num_kept = 0;
+                for (int i = 0; i < cell.size(); ++i) {
+                    if (Vector2DistanceSqr(cell.at(i), pos) < dist_sqr) {
+                        continue;
+                    }
+                    cell.xs[num_kept] = cell.xs[i];
+                    cell.ys[num_kept] = cell.ys[i];
+                    num_kept++;
+                }
+                num_removed += cell.size() - num_kept;
+                cell.xs.resize(num_kept);
+                cell.ys.resize(num_kept);
+            }
+        }
+        if (num_removed > 0) {
+            repairDistanceField(pos, dist);
+        }
+        return num_removed;
+    }
+};
+
+inline ObstacleGrid makeObstacleGrid(const Obstacles& obstacles) {
+    ObstacleGrid obstacle_grid;
+    obstacle_grid.build(obstacles);
+    return obstacle_grid;
+}
+
+// Exact segment test against every obstacle in the cells overlapping the segment's bounding box grown by the obstacle radius.
+inline bool segmentCollidesExact(const Vector2 start, const Vector2 goal, const ObstacleGrid& obstacle_grid) {
+    const Vector2 lo = {std::min(start.x, goal.x) - OBSTACLE_RADIUS, std::min(start.y, goal.y) - OBSTACLE_RADIUS};
+    const Vector2 hi = {std::max(start.x, goal.x) + OBSTACLE_RADIUS, std::max(start.y, goal.y) + OBSTACLE_RADIUS};
+    return obstacle_grid.anyCellInBox(lo, hi, [&](const ObstacleCell& cell) { return segmentCollidesAny(start, goal, cell.xs.data(), cell.ys.data(), cell.size()); });
+}
+
+// Sphere tracing through the distance field: every point within the clearance lower bound of the current point is free,
+// so the trace can jump that far along the segment. A lookup that is too close to an obstacle boundary to decide
+// hands the rest of the segment to the exact test, so results always match segmentCollidesExact.
+inline bool segmentCollides(const Vector2 start, const Vector2 goal, const ObstacleGrid& obstacle_grid) {
+    const DistanceField& distance_field = obstacle_grid.distance_field;
+    if (!(DistanceField::covers(start) && DistanceField::covers(goal))) {
+        return segmentCollidesExact(start, goal, obstacle_grid);
+    }
+
+    const Vector2 delta = goal - start;
+    const float length = Vector2Length(delta);
+    const Vector2 dir = (length > 0.0f) ? Vector2Scale(delta, 1.0f / length) : Vector2{0.0f, 0.0f};
+
+    float t = 0.0f;
+    while (true) {
+        const Vector2 pos = start + dir * t;
+        const float clearance = distance_field.lookup(pos);
+        if (clearance < -DistanceField::CELL_HALF_DIAGONAL) {
+            return true;
+        }
+
+        // Require steps of at least a cell half diagonal so the trace always makes progress.
+        const float step = clearance - DistanceField::CELL_HALF_DIAGONAL;
+        if (step < DistanceField::CELL_HALF_DIAGONAL) {
+            return segmentCollidesExact(pos, goal, obstacle_grid);
+        }
+
+        t += step;
+        if (t >= length) {
+            return false;
+        }
+    }
+}
+
+inline bool collides(const Vector2 pos, const ObstacleGrid& obstacle_grid) {
+    return segmentCollides(pos, pos, obstacle_grid);
+}
@@ -1,9 +1,40 @@
 #pragma once
 
+#include <algorithm>
+
 #include "core/obstacle.h"
+#include "core/obstacle_grid.h"
 
 struct Problem {
     Obstacles obstacles;
     Vector2 start;
     Vector2 goal;
+    ObstacleGrid obstacle_grid;
+
+    // All obstacle edits go through these so the broadphase grid stays in sync with the obstacle list.
+    void addObstacle(const Obstacle obstacle) {
+        obstacles.push_back(obstacle);
+        obstacle_grid.insert(obstacle);
+    }
+
+    // Removed obstacles are appended to removed_obstacles.
+    bool removeObstaclesWithin(const Vector2 pos, const float dist, Obstacles& removed_obstacles) {
+        if (obstacle_grid.removeWithin(pos, dist) == 0) {
+            return false;
+        }
+        const float dist_sqr = dist * dist;
+        const auto removed = std::stable_partition(obstacles.begin(), obstacles.end(), [&](const Obstacle o) { return Vector2DistanceSqr(o, pos) >= dist_sqr; });
+        removed_obstacles.insert(removed_obstacles.end(), removed, obstacles.end());
+        obstacles.erase(removed, obstacles.end());
+        return true;
+    }
+
+    void clearObstacles() {
+        obstacles.clear();
+        obstacle_grid.clear();
+    }
 };
+
+inline Problem makeProblem(const Obstacles& obstacles, const Vector2 start, const Vector2 goal) {
+    return {obstacles, start, goal, makeObstacleGrid(obstacles)};
+}
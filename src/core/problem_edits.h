@@ -1,6 +1,14 @@
 #pragma once
 
+#include "core/obstacle.h"
+
 struct ProblemEdits {
     bool start_changed;
+    bool goal_changed;
     bool obstacle_added;
+    bool obstacle_removed;
+
+    // Obstacles added and removed by this edit, so planners only need to re-check edges near them.
+    Obstacles added_obstacles;
+    Obstacles removed_obstacles;
 };
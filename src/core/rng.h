@@ -1,5 +1,92 @@
 #pragma once
 
-#include <random>
+#include <cstdint>
+#include <limits>
 
-std::mt19937 rng(std::random_device{}());
+// Counter-based random streams.
+// Each output is a hash of the stream key and a counter, so any stream can be created and advanced independently of
+// every other. Work split across threads draws from streams keyed by work item rather than by thread, which keeps
+// results identical for a given seed regardless of thread count.
+
+// SplitMix64 finalizer.
+inline std::uint64_t mix64(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// lowbias32 integer hash.
+inline std::uint32_t hash32(std::uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+enum class RngPurpose : std::uint64_t {
+    SAMPLE,
+    CARRY,
+};
+
+struct Rng {
+    using result_type = std::uint64_t;
+
+    static constexpr std::uint64_t GAMMA = 0x9e3779b97f4a7c15ULL;
+
+    std::uint64_t key;
+    std::uint64_t counter = 0;
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()() {
+        counter++;
+        return mix64(key + GAMMA * counter);
+    }
+
+    // Uniform in [0, 1), from the top 24 bits so every value is exactly representable.
+    float uniform() {
+        return static_cast<float>((*this)() >> 40) * 0x1.0p-24f;
+    }
+
+    float uniform(const float lo, const float hi) {
+        return lo + (hi - lo) * uniform();
+    }
+
+    // Uniform in [0, n) for n up to 2^32, by scaling the top 32 bits rather than taking a modulus.
+    std::uint32_t uniformIndex(const std::uint32_t n) {
+        return static_cast<std::uint32_t>((((*this)() >> 32) * n) >> 32);
+    }
+
+    // Draw number `draw` of work item `index`. A pure function of the key, so a whole batch of items
+    // can be drawn in lockstep. Uses a 32-bit hash so the arithmetic vectorizes.
+    float uniformAt(const std::uint32_t index, const std::uint32_t draw) const {
+        const std::uint32_t key_lo = static_cast<std::uint32_t>(key);
+        const std::uint32_t key_hi = static_cast<std::uint32_t>(key >> 32);
+        const std::uint32_t h = hash32(hash32(key_lo ^ index) + key_hi + draw * 0x9e3779b9u);
+        return static_cast<float>(static_cast<std::int32_t>(h >> 8)) * 0x1.0p-24f;
+    }
+
+    // Independent child stream, e.g. one per purpose or per work item.
+    Rng fork(const std::uint64_t index) const {
+        return {mix64(key ^ mix64(index + GAMMA))};
+    }
+
+    Rng fork(const RngPurpose purpose) const {
+        return fork(static_cast<std::uint64_t>(purpose));
+    }
+};
+
+inline Rng makeRng(const std::uint64_t seed) {
+    return {mix64(seed)};
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent worker threads for data-parallel loops.
+// The calling thread takes part in every loop, so a pool without workers simply runs serially.
+struct ThreadPool {
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    std::function<void(int)> task;
+    std::atomic<int> next_index = 0;
+    int count = 0;
+    int num_busy = 0;
+    std::uint64_t generation = 0;
+    bool stopping = false;
+
+    explicit ThreadPool(const int num_workers) {
+        for (int i = 0; i < num_workers; ++i) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        work_ready.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    int numThreads() const {
+        return static_cast<int>(workers.size()) + 1;
+    }
+
+    // Call fn(i) for every i in [0, n) across the pool, returning once all calls have finished.
+    void parallelFor(const int n, const std::function<void(int)>& fn) {
+        if (workers.empty() || (n <= 1)) {
+            for (int i = 0; i < n; ++i) {
+                fn(i);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = fn;
+            count = n;
+            next_index = 0;
+            num_busy = static_cast<int>(workers.size());
+            generation++;
+        }
+        work_ready.notify_all();
+
+        runTasks();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        work_done.wait(lock, [this] { return num_busy == 0; });
+    }
+
+    void runTasks() {
+        for (int i = next_index.fetch_add(1); i < count; i = next_index.fetch_add(1)) {
+            task(i);
+        }
+    }
+
+    void workerLoop() {
+        std::uint64_t generation_seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                work_ready.wait(lock, [&] { return stopping || (generation != generation_seen); });
+                if (stopping) {
+                    return;
+                }
+                generation_seen = generation;
+            }
+
+            runTasks();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                num_busy--;
+                if (num_busy == 0) {
+                    work_done.notify_one();
+                }
+            }
+        }
+    }
+};
+
+inline int defaultNumWorkers() {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    return 0;
+#else
+    return std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0);
+#endif
+}
+
+inline ThreadPool& getThreadPool() {
+    static ThreadPool thread_pool(defaultNumWorkers());
+    return thread_pool;
+}
@@ -1,12 +1,11 @@
 #pragma once
 
-#include <raylib.h>
-
 #include <deque>
 #include <numeric>
 #include <utility>
 
 #include "config.h"
+#include "core/clock.h"
 
 struct Observation {
     float timestamp;
@@ -18,11 +17,11 @@ struct Timing {
     float start_time;
 
     void start() {
-        start_time = GetTime();
+        start_time = getTime();
     }
 
     void record() {
-        const float now = GetTime();
+        const float now = getTime();
         const float duration = now - start_time;
         history.emplace_back(Observation{now, duration});
 
@@ -12,7 +12,6 @@
 #include "config.h"
 #include "core/obstacle.h"
 #include "core/problem.h"
-#include "core/rng.h"
 #include "core/timing_parts.h"
 #include "planner/planner.h"
 #include "raygui.h"
@@ -36,7 +35,11 @@
 // - should return artifact describing how problem was edited
 ProblemEdits editProblem(Problem& problem, const Vector2 brush_pos, const Vector2 brush_pos_prev, const bool is_down_lmb, const ProblemEditMode mode, const ProblemEditMode mode_prev, const bool mouse_in_environment, const bool reset_obstacles, const bool active_prev) {
     bool start_changed = false;
+    bool goal_changed = false;
     bool obstacle_added = false;
+    Obstacles added_obstacles;
+    bool obstacle_removed = false;
+    Obstacles removed_obstacles;
     if (mouse_in_environment && is_down_lmb) {
         int n = 0;
         if (mode == mode_prev && active_prev) {
@@ -61,6 +64,7 @@ ProblemEdits editProblem(Problem& problem, const Vector2 brush_pos, const Vector
                 break;
             }
             case ProblemEditMode::PLACE_GOAL: {
+                goal_changed = Vector2DistanceSqr(problem.goal, brush_pos) > 0.0f;
                 problem.goal = brush_pos;
                 break;
             }
@@ -68,8 +72,9 @@ ProblemEdits editProblem(Problem& problem, const Vector2 brush_pos, const Vector
                 for (int i = 1; i <= n; ++i) {
                     const float t = static_cast<float>(i) / static_cast<float>(n);
                     const Vector2 new_obs_pos = Vector2Lerp(brush_pos_prev, brush_pos, t);
-                    if (std::none_of(problem.obstacles.begin(), problem.obstacles.end(), [&](auto& o) { return Vector2Distance(o, new_obs_pos) < OBSTACLE_SPACING_MIN; })) {
-                        problem.obstacles.push_back(new_obs_pos);
+                    if (!problem.obstacle_grid.anyWithin(new_obs_pos, OBSTACLE_SPACING_MIN)) {
+                        problem.addObstacle(new_obs_pos);
+                        added_obstacles.push_back(new_obs_pos);
                         obstacle_added = true;
                     }
                 }
@@ -79,7 +84,9 @@ ProblemEdits editProblem(Problem& problem, const Vector2 brush_pos, const Vector
                 for (int i = 1; i <= n; ++i) {
                     const float t = static_cast<float>(i) / static_cast<float>(n);
                     const Vector2 del_pos = Vector2Lerp(brush_pos_prev, brush_pos, t);
-                    problem.obstacles.erase(std::remove_if(problem.obstacles.begin(), problem.obstacles.end(), [&](Vector2 o) { return Vector2Distance(o, del_pos) < (OBSTACLE_RADIUS + OBSTACLE_DELETE_RADIUS); }), problem.obstacles.end());
+                    if (problem.removeObstaclesWithin(del_pos, OBSTACLE_RADIUS + OBSTACLE_DELETE_RADIUS, removed_obstacles)) {
+                        obstacle_removed = true;
+                    }
                 }
                 break;
             }
@@ -90,10 +97,12 @@ ProblemEdits editProblem(Problem& problem, const Vector2 brush_pos, const Vector
     }
 
     if (reset_obstacles) {
-        problem.obstacles = {};
+        removed_obstacles.insert(removed_obstacles.end(), problem.obstacles.begin(), problem.obstacles.end());
+        problem.clearObstacles();
+        obstacle_removed = true;
     }
 
-    return {start_changed, obstacle_added};
+    return {start_changed, goal_changed, obstacle_added, obstacle_removed, added_obstacles, removed_obstacles};
 }
 
 int main() {
@@ -136,15 +145,21 @@ int main() {
     // PLAN SETTINGS INIT
     CtrlState ctrl_state;
     const int num_carry = NUM_CARRY_OPTIONS[ctrl_state.num_carry_ix];
+    const CarryPolicy carry_policy = ctrl_state.carry_policy;
     const int num_samples = NUM_SAMPLES_OPTIONS[ctrl_state.num_samples_ix];
     const bool rewire_enabled = ctrl_state.rewire_enabled;
-    const PlanSettings plan_settings = {num_carry, num_samples, rewire_enabled};
+    const ConnectionMode connection_mode = ctrl_state.connection_mode;
+    const bool parallel_grow_enabled = ctrl_state.parallel_grow_enabled;
+    const bool informed_sampling_enabled = ctrl_state.informed_sampling_enabled;
+    const bool reroot_enabled = ctrl_state.reroot_enabled;
+    const bool rrtx_enabled = ctrl_state.rrtx_enabled;
+    const PlanSettings plan_settings = {num_carry, carry_policy, num_samples, rewire_enabled, connection_mode, parallel_grow_enabled, informed_sampling_enabled, reroot_enabled, rrtx_enabled};
 
     // TIMING INIT
     AppTimingParts app_timing;
 
     // ENVIRONMENT INIT
-    Problem problem = {DEFAULT_OBSTACLES, DEFAULT_START, DEFAULT_GOAL};
+    Problem problem = makeProblem(DEFAULT_OBSTACLES, DEFAULT_START, DEFAULT_GOAL);
 
     // PLANNER INIT
     Planner planner;
@@ -174,16 +189,22 @@ int main() {
         active_prev = mouse_in_environment && is_down_lmb;
 
         const int num_carry = NUM_CARRY_OPTIONS[ctrl_state.num_carry_ix];
+        const CarryPolicy carry_policy = ctrl_state.carry_policy;
         const int num_samples = NUM_SAMPLES_OPTIONS[ctrl_state.num_samples_ix];
         const bool rewire_enabled = ctrl_state.rewire_enabled;
-        const PlanSettings plan_settings = {num_carry, num_samples, rewire_enabled};
+        const ConnectionMode connection_mode = ctrl_state.connection_mode;
+        const bool parallel_grow_enabled = ctrl_state.parallel_grow_enabled;
+        const bool informed_sampling_enabled = ctrl_state.informed_sampling_enabled;
+        const bool reroot_enabled = ctrl_state.reroot_enabled;
+        const bool rrtx_enabled = ctrl_state.rrtx_enabled;
+        const PlanSettings plan_settings = {num_carry, carry_policy, num_samples, rewire_enabled, connection_mode, parallel_grow_enabled, informed_sampling_enabled, reroot_enabled, rrtx_enabled};
 
         // ---- PLANNER LOGIC
         const ActionSettings action_settings = {problem_edits, ctrl_state.tree_edits};
 
         planner.plan(problem, plan_settings, action_settings);
 
-        const bool goal_reached = goalReached(planner.path, problem.goal);
+        const bool goal_reached = goalReached(planner.pool(), planner.path, planner.pathTarget(problem));
 
         const DurationParts duration = {planner.timing.grow.averageDuration(), planner.timing.carry.averageDuration(), planner.timing.cull.averageDuration(), app_timing.draw.averageDuration(), app_timing.total.averageDuration()};
 
@@ -1,8 +1,7 @@
 #pragma once
 
-#include <raylib.h>
-#include <raymath.h>
+#include "core/math.h"
 
-float computeCost(const Vector2 a, const Vector2 b) {
+inline float computeCost(const Vector2 a, const Vector2 b) {
     return Vector2Distance(a, b);
 }
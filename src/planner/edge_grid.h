@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "config.h"
+#include "core/math.h"
+#include "planner/node.h"
+
+// Uniform bucket grid of tree edges, each filed under every cell its bounding box overlaps, so the edges an
+// obstacle may block can be found without walking the tree. An edge is identified by its child node.
+// Rewires only add entries, so a cell may still list a node whose edge has since moved elsewhere, or whose slot has
+// since been freed; callers skip freed nodes, re-read the current edge and test it exactly.
+struct EdgeGrid {
+    static constexpr int NUM_COLS = (ENVIRONMENT_WIDTH + EDGE_GRID_CELL_SIZE - 1) / EDGE_GRID_CELL_SIZE;
+    static constexpr int NUM_ROWS = (ENVIRONMENT_HEIGHT + EDGE_GRID_CELL_SIZE - 1) / EDGE_GRID_CELL_SIZE;
+    static constexpr float CELL_SIZE_INV = 1.0f / EDGE_GRID_CELL_SIZE;
+
+    std::vector<NodeIds> cells = std::vector<NodeIds>(NUM_COLS * NUM_ROWS);
+
+    static int colOf(const float x) {
+        return std::clamp(static_cast<int>((x - ENVIRONMENT_X_MIN) * CELL_SIZE_INV), 0, NUM_COLS - 1);
+    }
+
+    static int rowOf(const float y) {
+        return std::clamp(static_cast<int>((y - ENVIRONMENT_Y_MIN) * CELL_SIZE_INV), 0, NUM_ROWS - 1);
+    }
+
+    void clear() {
+        for (NodeIds& cell : cells) {
+            cell.clear();
+        }
+    }
+
+    // Visit the index of every cell the bounding box of the node's current edge overlaps.
+    template <typename Visitor>
+    static void forEachCellOf(const NodePool& pool, const NodeId node, Visitor&& visit) {
+        const Vector2 a = pool.pos[pool.parent[node]];
+        const Vector2 b = pool.pos[node];
+        const int col_min = colOf(std::min(a.x, b.x));
+        const int col_max = colOf(std::max(a.x, b.x));
+        const int row_min = rowOf(std::min(a.y, b.y));
+        const int row_max = rowOf(std::max(a.y, b.y));
+        for (int row = row_min; row <= row_max; ++row) {
+            for (int col = col_min; col <= col_max; ++col) {
+                visit(row * NUM_COLS + col);
+            }
+        }
+    }
+
+    // File the edge from the node's current parent. Call again whenever the node is reparented.
+    void insert(const NodePool& pool, const NodeId node) {
+        if (!pool.hasParent(node)) {
+            return;
+        }
+        forEachCellOf(pool, node, [&](const int cell_id) { cells[cell_id].push_back(node); });
+    }
+
+    // Drop the current edges of the given nodes, all of which must be marked and still attached, sweeping only the
+    // cells those edges overlap. Entries left under other cells by earlier rewires stay until the next rebuild.
+    void remove(const NodePool& pool, const NodeIds& nodes, const NodeMarks& marks) {
+        std::vector<bool> is_touched(cells.size(), false);
+        for (const NodeId node : nodes) {
+            if (pool.hasParent(node)) {
+                forEachCellOf(pool, node, [&](const int cell_id) { is_touched[cell_id] = true; });
+            }
+        }
+        for (std::size_t cell_id = 0; cell_id < cells.size(); ++cell_id) {
+            if (is_touched[cell_id]) {
+                std::erase_if(cells[cell_id], [&](const NodeId node) { return marks.contains(node); });
+            }
+        }
+    }
+
+    void build(const NodePool& pool, const NodeIds& nodes) {
+        clear();
+        for (const NodeId node : nodes) {
+            insert(pool, node);
+        }
+    }
+
+    // Visit every node filed under a cell overlapping the box [lo, hi]. A node may be visited more than once.
+    template <typename Visitor>
+    void forEachInBox(const Vector2 lo, const Vector2 hi, Visitor&& visit) const {
+        const int col_min = colOf(lo.x);
+        const int col_max = colOf(hi.x);
+        const int row_min = rowOf(lo.y);
+        const int row_max = rowOf(hi.y);
+        for (int row = row_min; row <= row_max; ++row) {
+            for (int col = col_min; col <= col_max; ++col) {
+                for (const NodeId node : cells[row * NUM_COLS + col]) {
+                    visit(node);
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "config.h"
+#include "core/math.h"
+
+// Prolate ellipse with foci at start and goal, holding every point that could lie on a path cheaper than cost_best.
+// Samples outside it cannot improve the current solution.
+struct InformedSet {
+    Vector2 center;
+    Vector2 axis;
+    float semi_major;
+    float semi_minor;
+
+    bool isBounded() const {
+        return std::isfinite(semi_minor);
+    }
+
+    bool contains(const Vector2 pos) const {
+        const Vector2 delta = pos - center;
+        const float u = (delta.x * axis.x + delta.y * axis.y) / semi_major;
+        const float v = (delta.y * axis.x - delta.x * axis.y) / semi_minor;
+        return (u * u + v * v) <= 1.0f;
+    }
+
+    float area() const {
+        return M_PI * semi_major * semi_minor;
+    }
+
+    // Fraction of the environment area covered, capped at one.
+    float coverage() const {
+        return isBounded() ? std::min(area() / (ENVIRONMENT_WIDTH * ENVIRONMENT_HEIGHT), 1.0f) : 1.0f;
+    }
+};
+
+inline InformedSet makeInformedSet(const Vector2 start, const Vector2 goal, const float cost_best) {
+    const float cost_min = Vector2Distance(start, goal);
+    const Vector2 axis = (cost_min > 0.0f) ? Vector2Scale(goal - start, 1.0f / cost_min) : Vector2{1.0f, 0.0f};
+    const float semi_major = 0.5f * cost_best;
+    const float semi_minor = 0.5f * std::sqrt(std::max(cost_best * cost_best - cost_min * cost_min, 0.0f));
+    return {Vector2Lerp(start, goal, 0.5f), axis, semi_major, semi_minor};
+}
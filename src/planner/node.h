@@ -1,39 +1,210 @@
 #pragma once
 
-#include <raylib.h>
-
-#include <functional>
-#include <memory>
-#include <unordered_set>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
+#include "core/math.h"
 #include "cost.h"
 
-struct Node;
+// Nodes are referred to by 32-bit handles into a NodePool.
+// A handle stays valid until its node is removed, after which the slot may be reused.
+using NodeId = std::uint32_t;
+using NodeIds = std::vector<NodeId>;
 
-using NodePtr = std::shared_ptr<Node>;
-using Nodes = std::vector<NodePtr>;
+static constexpr NodeId NULL_NODE = std::numeric_limits<NodeId>::max();
 
-struct Node {
-    NodePtr parent;
-    Vector2 pos;
-    float cost_to_come;
+// Struct-of-arrays node storage, indexed by NodeId.
+// Children are kept as intrusive first-child / next-sibling lists.
+struct NodePool {
+    std::vector<Vector2> pos;
+    std::vector<float> cost_to_come;
+    std::vector<NodeId> parent;
+    std::vector<NodeId> first_child;
+    std::vector<NodeId> next_sibling;
+    NodeIds free_ids;
 
-    float estimateCostTo(const Vector2 goal) {
-        return cost_to_come + computeCost(pos, goal);
+    // Number of slots, live or free. Per-node side arrays should be sized to this.
+    std::size_t capacity() const {
+        return pos.size();
     }
-};
 
-struct NodePtrHash {
-    std::size_t operator()(const NodePtr& n) const noexcept {
-        return std::hash<Node*>()(n.get());
+    NodeId add(const Vector2 node_pos, const float node_cost_to_come, const NodeId node_parent) {
+        NodeId id = NULL_NODE;
+        if (!free_ids.empty()) {
+            id = free_ids.back();
+            free_ids.pop_back();
+            pos[id] = node_pos;
+            cost_to_come[id] = node_cost_to_come;
+            parent[id] = NULL_NODE;
+            first_child[id] = NULL_NODE;
+            next_sibling[id] = NULL_NODE;
+        } else {
+            id = static_cast<NodeId>(pos.size());
+            pos.push_back(node_pos);
+            cost_to_come.push_back(node_cost_to_come);
+            parent.push_back(NULL_NODE);
+            first_child.push_back(NULL_NODE);
+            next_sibling.push_back(NULL_NODE);
+        }
+
+        if (node_parent != NULL_NODE) {
+            link(id, node_parent);
+        }
+        return id;
+    }
+
+    // Attach a parentless node as the first child of new_parent.
+    void link(const NodeId id, const NodeId new_parent) {
+        parent[id] = new_parent;
+        next_sibling[id] = first_child[new_parent];
+        first_child[new_parent] = id;
+    }
+
+    // Detach a node from its parent's child list, leaving it parentless.
+    void unlink(const NodeId id) {
+        const NodeId old_parent = parent[id];
+        if (old_parent == NULL_NODE) {
+            return;
+        }
+
+        if (first_child[old_parent] == id) {
+            first_child[old_parent] = next_sibling[id];
+        } else {
+            NodeId sibling = first_child[old_parent];
+            while (next_sibling[sibling] != id) {
+                sibling = next_sibling[sibling];
+            }
+            next_sibling[sibling] = next_sibling[id];
+        }
+        parent[id] = NULL_NODE;
+        next_sibling[id] = NULL_NODE;
+    }
+
+    // Detach every child of the node that pred accepts, in one pass over its child list.
+    template <typename Predicate>
+    void unlinkChildrenIf(const NodeId id, Predicate&& pred) {
+        NodeId* link_ptr = &first_child[id];
+        while (*link_ptr != NULL_NODE) {
+            const NodeId child = *link_ptr;
+            if (pred(child)) {
+                *link_ptr = next_sibling[child];
+                parent[child] = NULL_NODE;
+                next_sibling[child] = NULL_NODE;
+            } else {
+                link_ptr = &next_sibling[child];
+            }
+        }
+    }
+
+    void reparent(const NodeId id, const NodeId new_parent) {
+        unlink(id);
+        link(id, new_parent);
+    }
+
+    // Rebuild all child lists of the given nodes from their parent handles in one linear pass.
+    // Parents outside the given set must not be referenced.
+    void relink(const NodeIds& nodes) {
+        for (const NodeId node : nodes) {
+            first_child[node] = NULL_NODE;
+        }
+        for (const NodeId node : nodes) {
+            if (parent[node] != NULL_NODE) {
+                next_sibling[node] = first_child[parent[node]];
+                first_child[parent[node]] = node;
+            } else {
+                next_sibling[node] = NULL_NODE;
+            }
+        }
+    }
+
+    // Free the slot of a node with no parent or children left among live nodes. A freed slot reads as parentless,
+    // so stale references to it can be told apart from live non-root nodes.
+    void remove(const NodeId id) {
+        parent[id] = NULL_NODE;
+        free_ids.push_back(id);
     }
-};
 
-struct NodePtrEq {
-    bool operator()(const NodePtr& a, const NodePtr& b) const noexcept {
-        return a.get() == b.get();
+    // Keep only the given nodes, moved to handles 0, 1, ... in the order given, and drop every other slot without
+    // visiting it. The kept nodes must hold every parent they reference. new_ids is scratch, indexed by old handle,
+    // that maps each kept node to its new handle. Child lists are left for relink.
+    void compact(const NodeIds& kept, std::vector<NodeId>& new_ids) {
+        if (new_ids.size() < capacity()) {
+            new_ids.resize(capacity());
+        }
+        for (std::size_t i = 0; i < kept.size(); ++i) {
+            new_ids[kept[i]] = static_cast<NodeId>(i);
+        }
+
+        std::vector<Vector2> kept_pos(kept.size());
+        std::vector<float> kept_cost_to_come(kept.size());
+        std::vector<NodeId> kept_parent(kept.size());
+        for (std::size_t i = 0; i < kept.size(); ++i) {
+            const NodeId id = kept[i];
+            kept_pos[i] = pos[id];
+            kept_cost_to_come[i] = cost_to_come[id];
+            kept_parent[i] = (parent[id] != NULL_NODE) ? new_ids[parent[id]] : NULL_NODE;
+        }
+
+        pos = std::move(kept_pos);
+        cost_to_come = std::move(kept_cost_to_come);
+        parent = std::move(kept_parent);
+        first_child.assign(kept.size(), NULL_NODE);
+        next_sibling.assign(kept.size(), NULL_NODE);
+        free_ids.clear();
+    }
+
+    void clear() {
+        pos.clear();
+        cost_to_come.clear();
+        parent.clear();
+        first_child.clear();
+        next_sibling.clear();
+        free_ids.clear();
+    }
+
+    bool hasParent(const NodeId id) const {
+        return parent[id] != NULL_NODE;
+    }
+
+    float estimateCostTo(const NodeId id, const Vector2 goal) const {
+        return cost_to_come[id] + computeCost(pos[id], goal);
     }
 };
 
-using NodeSet = std::unordered_set<NodePtr, NodePtrHash, NodePtrEq>;
\ No newline at end of file
+// Set of node handles stored as per-slot epoch stamps. Clearing advances the epoch instead of touching every slot,
+// so a pass that marks only a few nodes costs nothing for the rest of the pool.
+struct NodeMarks {
+    std::vector<std::uint32_t> stamps;
+    std::uint32_t epoch = 0;
+
+    void clear(const std::size_t capacity) {
+        stamps.resize(capacity, 0);
+        epoch++;
+        if (epoch == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    // Make room for ids below capacity, keeping current marks.
+    void grow(const std::size_t capacity) {
+        if (stamps.size() < capacity) {
+            stamps.resize(capacity, 0);
+        }
+    }
+
+    bool contains(const NodeId id) const {
+        return stamps[id] == epoch;
+    }
+
+    // Returns false if the node was already marked.
+    bool insert(const NodeId id) {
+        if (contains(id)) {
+            return false;
+        }
+        stamps[id] = epoch;
+        return true;
+    }
+};
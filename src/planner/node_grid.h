@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "config.h"
+#include "core/math.h"
+#include "planner/cost.h"
+#include "planner/node.h"
+
+// Grid entries carry a copy of the node position so queries never touch the node pool.
+struct NodeGridEntry {
+    Vector2 pos;
+    NodeId id;
+};
+
+using NodeGridCell = std::vector<NodeGridEntry>;
+
+// Uniform bucket grid over the environment, used to answer nearest and radius queries
+// without scanning every node in the tree.
+struct NodeGrid {
+    static constexpr int NUM_COLS = (ENVIRONMENT_WIDTH + NODE_GRID_CELL_SIZE - 1) / NODE_GRID_CELL_SIZE;
+    static constexpr int NUM_ROWS = (ENVIRONMENT_HEIGHT + NODE_GRID_CELL_SIZE - 1) / NODE_GRID_CELL_SIZE;
+    static constexpr float CELL_SIZE_INV = 1.0f / NODE_GRID_CELL_SIZE;
+
+    std::vector<NodeGridCell> cells = std::vector<NodeGridCell>(NUM_COLS * NUM_ROWS);
+
+    static int colOf(const float x) {
+        return std::clamp(static_cast<int>((x - ENVIRONMENT_X_MIN) * CELL_SIZE_INV), 0, NUM_COLS - 1);
+    }
+
+    static int rowOf(const float y) {
+        return std::clamp(static_cast<int>((y - ENVIRONMENT_Y_MIN) * CELL_SIZE_INV), 0, NUM_ROWS - 1);
+    }
+
+    void clear() {
+        for (NodeGridCell& cell : cells) {
+            cell.clear();
+        }
+    }
+
+    void insert(const NodeId id, const Vector2 pos) {
+        cells[rowOf(pos.y) * NUM_COLS + colOf(pos.x)].push_back({pos, id});
+    }
+
+    void build(const NodePool& pool, const NodeIds& nodes) {
+        clear();
+        for (const NodeId node : nodes) {
+            insert(node, pool.pos[node]);
+        }
+    }
+
+    void remove(const NodeId id, const Vector2 pos) {
+        std::erase_if(cells[rowOf(pos.y) * NUM_COLS + colOf(pos.x)], [&](const NodeGridEntry& entry) { return entry.id == id; });
+    }
+
+    // Drop the given nodes, all of which must be marked, sweeping only the cells that hold them.
+    void remove(const NodePool& pool, const NodeIds& ids, const NodeMarks& marks) {
+        std::vector<bool> is_touched(cells.size(), false);
+        for (const NodeId id : ids) {
+            is_touched[rowOf(pool.pos[id].y) * NUM_COLS + colOf(pool.pos[id].x)] = true;
+        }
+        for (std::size_t cell_id = 0; cell_id < cells.size(); ++cell_id) {
+            if (is_touched[cell_id]) {
+                std::erase_if(cells[cell_id], [&](const NodeGridEntry& entry) { return marks.contains(entry.id); });
+            }
+        }
+    }
+
+    // Number of nodes in the cell holding pos.
+    int occupancy(const Vector2 pos) const {
+        return static_cast<int>(cells[rowOf(pos.y) * NUM_COLS + colOf(pos.x)].size());
+    }
+
+    // Mean number of nodes over the cells holding at least one.
+    float meanOccupancy() const {
+        int num_nodes = 0;
+        int num_occupied = 0;
+        for (const NodeGridCell& cell : cells) {
+            num_nodes += static_cast<int>(cell.size());
+            num_occupied += cell.empty() ? 0 : 1;
+        }
+        return (num_occupied > 0) ? static_cast<float>(num_nodes) / num_occupied : 0.0f;
+    }
+
+    // Visit every node within max_dist of target, passing the node and its distance to target.
+    template <typename Visitor>
+    void forEachWithin(const Vector2 target, const float max_dist, Visitor&& visit) const {
+        const int col_min = colOf(target.x - max_dist);
+        const int col_max = colOf(target.x + max_dist);
+        const int row_min = rowOf(target.y - max_dist);
+        const int row_max = rowOf(target.y + max_dist);
+        for (int row = row_min; row <= row_max; ++row) {
+            for (int col = col_min; col <= col_max; ++col) {
+                for (const NodeGridEntry& entry : cells[row * NUM_COLS + col]) {
+                    const float dist = computeCost(entry.pos, target);
+                    if (dist <= max_dist) {
+                        visit(entry.id, dist);
+                    }
+                }
+            }
+        }
+    }
+
+    // Visit every node within max_dist of target, ring by ring outward from the target cell, passing the node and its
+    // distance to target. After each ring, stop(reach) may end the search, where no unvisited node is closer than reach.
+    template <typename Visitor, typename Stop>
+    void forEachWithinByRing(const Vector2 target, const float max_dist, Visitor&& visit, Stop&& stop) const {
+        const int col_center = colOf(target.x);
+        const int row_center = rowOf(target.y);
+
+        // Distance from the target to the nearest side of its own cell; ring r then reaches r cells further.
+        const float x_min = ENVIRONMENT_X_MIN + col_center * NODE_GRID_CELL_SIZE;
+        const float y_min = ENVIRONMENT_Y_MIN + row_center * NODE_GRID_CELL_SIZE;
+        const float margin = std::max(0.0f, std::min({target.x - x_min, x_min + NODE_GRID_CELL_SIZE - target.x, target.y - y_min, y_min + NODE_GRID_CELL_SIZE - target.y}));
+
+        const auto visit_cell = [&](const int row, const int col) {
+            if ((row < 0) || (row >= NUM_ROWS) || (col < 0) || (col >= NUM_COLS)) {
+                return;
+            }
+            for (const NodeGridEntry& entry : cells[row * NUM_COLS + col]) {
+                const float dist = computeCost(entry.pos, target);
+                if (dist <= max_dist) {
+                    visit(entry.id, dist);
+                }
+            }
+        };
+
+        const int ring_max = std::max({col_center, NUM_COLS - 1 - col_center, row_center, NUM_ROWS - 1 - row_center});
+        for (int ring = 0; ring <= ring_max; ++ring) {
+            if (ring == 0) {
+                visit_cell(row_center, col_center);
+            } else {
+                for (int col = col_center - ring; col <= col_center + ring; ++col) {
+                    visit_cell(row_center - ring, col);
+                    visit_cell(row_center + ring, col);
+                }
+                for (int row = row_center - ring + 1; row <= row_center + ring - 1; ++row) {
+                    visit_cell(row, col_center - ring);
+                    visit_cell(row, col_center + ring);
+                }
+            }
+
+            const float reach = margin + ring * NODE_GRID_CELL_SIZE;
+            if ((reach >= max_dist) || stop(reach)) {
+                break;
+            }
+        }
+    }
+
+    // Search rings of cells outward from the target cell until no unvisited cell can hold a closer node.
+    NodeId nearest(const Vector2 target) const {
+        const int col_center = colOf(target.x);
+        const int row_center = rowOf(target.y);
+        const int ring_max = std::max({col_center, NUM_COLS - 1 - col_center, row_center, NUM_ROWS - 1 - row_center});
+
+        NodeId best = NULL_NODE;
+        float best_dist_sqr = std::numeric_limits<float>::infinity();
+
+        const auto visit_cell = [&](const int row, const int col) {
+            if ((row < 0) || (row >= NUM_ROWS) || (col < 0) || (col >= NUM_COLS)) {
+                return;
+            }
+            for (const NodeGridEntry& entry : cells[row * NUM_COLS + col]) {
+                const float dist_sqr = Vector2DistanceSqr(entry.pos, target);
+                if (dist_sqr < best_dist_sqr) {
+                    best_dist_sqr = dist_sqr;
+                    best = entry.id;
+                }
+            }
+        };
+
+        for (int ring = 0; ring <= ring_max; ++ring) {
+            if (ring == 0) {
+                visit_cell(row_center, col_center);
+            } else {
+                for (int col = col_center - ring; col <= col_center + ring; ++col) {
+                    visit_cell(row_center - ring, col);
+                    visit_cell(row_center + ring, col);
+                }
+                for (int row = row_center - ring + 1; row <= row_center + ring - 1; ++row) {
+                    visit_cell(row, col_center - ring);
+                    visit_cell(row, col_center + ring);
+                }
+            }
+
+            // Every cell in the next ring is at least this far from the target.
+            const float ring_dist = ring * NODE_GRID_CELL_SIZE;
+            if ((best != NULL_NODE) && (best_dist_sqr <= ring_dist * ring_dist)) {
+                break;
+            }
+        }
+        return best;
+    }
+};
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <raylib.h>
-
 #include "planner/node.h"
 
-using Path = std::vector<NodePtr>;
+using Path = NodeIds;
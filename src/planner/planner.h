@@ -1,17 +1,31 @@
 #pragma once
 
+#include <cstdint>
+#include <random>
+
+#include "core/carry_policy.h"
+#include "core/connection_mode.h"
 #include "core/problem.h"
 #include "core/problem_edits.h"
+#include "core/rng.h"
 #include "core/timing_parts.h"
 #include "core/tree_edits.h"
 #include "planner/node.h"
 #include "planner/path.h"
+#include "planner/rrtx.h"
 #include "planner/tree.h"
 
 struct PlanSettings {
     int num_carry;
+    CarryPolicy carry_policy;
     int num_samples;
     bool rewire_enabled;
+    ConnectionMode connection_mode;
+    bool parallel_grow_enabled;
+    bool informed_sampling_enabled;
+    bool reroot_enabled;
+    // Plan with the goal-rooted RRTX graph instead of the tree. The graph keeps every node, so num_carry does not apply.
+    bool rrtx_enabled;
 };
 
 struct ActionSettings {
@@ -21,53 +35,147 @@ struct ActionSettings {
 
 struct Planner {
     Tree tree;
+    RrtxTree rrtx;
+    bool rrtx_active = false;
     Path path;
     PlanningTimingParts timing;
 
+    // Every random draw derives from the seed and the plan count, so a run is reproducible from its seed.
+    std::uint64_t seed = std::random_device{}();
+    std::uint64_t num_plans = 0;
+
+    // The structure the path runs through: the tree grows from the start, the RRTX graph from the goal.
+    const NodePool& pool() const {
+        return rrtx_active ? rrtx.pool : tree.pool;
+    }
+
+    const NodeIds& nodes() const {
+        return rrtx_active ? rrtx.nodes : tree.nodes;
+    }
+
+    NodeId root() const {
+        return rrtx_active ? rrtx.root() : tree.root();
+    }
+
+    // Point the path heads for, away from the root.
+    Vector2 pathTarget(const Problem& problem) const {
+        return rrtx_active ? problem.start : problem.goal;
+    }
+
+    // Mean number of neighbors a node connects to. The RRTX graph always links every node within RRTX_NEIGHBOR_RADIUS.
+    float meanNeighborhoodSize() const {
+        return rrtx_active ? rrtx.meanDegree() : tree.mean_neighborhood_size;
+    }
+
+    InformedSet informedSet(const bool informed_enabled) const {
+        return rrtx_active ? rrtx.informedSet(informed_enabled) : tree.informedSet(informed_enabled);
+    }
+
     void plan(const Problem& problem, const PlanSettings& plan_settings, const ActionSettings& action_settings) {
-        if (action_settings.tree_edits.should_reset) {
-            tree.reset(problem.start);
+        const ProblemEdits& problem_edits = action_settings.problem_edits;
+        const Rng rng = makeRng(seed).fork(num_plans);
+        num_plans++;
+
+        // Neither structure tracks edits made while the other is active, so switching starts over.
+        const bool mode_changed = plan_settings.rrtx_enabled != rrtx_active;
+        rrtx_active = plan_settings.rrtx_enabled;
+        if (rrtx_active) {
+            planRrtx(problem, plan_settings, action_settings, mode_changed, rng);
+            return;
+        }
+
+        // After a reset the previous path refers to dropped nodes, or to the other structure, so nothing is carried.
+        const bool should_reset = action_settings.tree_edits.should_reset || mode_changed;
+        if (should_reset) {
+            tree.reset(problem);
         }
 
-        if (action_settings.problem_edits.start_changed) {
-            tree.resetRoot(problem, path);
+        if (problem_edits.goal_changed || problem_edits.obstacle_added || problem_edits.obstacle_removed) {
+            tree.updateGoalRegion(problem.goal, problem.obstacle_grid);
+        }
+
+        if (problem_edits.start_changed) {
+            if (plan_settings.reroot_enabled) {
+                tree.reroot(problem, path);
+            } else {
+                tree.resetRoot(problem, path);
+            }
+
+            // Re-rooting drops nodes, so the previous path may refer to recycled handles.
+            path = extractPath(tree.pool, tree.pathEnd());
         }
 
         timing.carry.start();
-        const bool do_carry = action_settings.tree_edits.should_grow && !action_settings.tree_edits.should_reset;
+        const bool do_carry = action_settings.tree_edits.should_grow && !should_reset;
         if (do_carry) {
-            tree.carry(path, plan_settings.num_carry, problem.obstacles);
+            tree.carry(path, plan_settings.num_carry, plan_settings.carry_policy, rng.fork(RngPurpose::CARRY));
         }
         timing.carry.record();
 
         timing.cull.start();
-        const bool do_cull = action_settings.problem_edits.obstacle_added || action_settings.problem_edits.start_changed;
+        const bool do_cull = problem_edits.obstacle_added || problem_edits.start_changed;
         if (do_cull) {
-            tree.cullByObstacles(problem.obstacles);
+            tree.cullByObstacles(problem_edits.added_obstacles, problem.obstacle_grid);
         }
         timing.cull.record();
 
         timing.grow.start();
         if (action_settings.tree_edits.should_grow) {
-            tree.grow(problem, plan_settings.num_samples, plan_settings.rewire_enabled);
+            tree.grow(problem, plan_settings.num_samples, plan_settings.rewire_enabled, plan_settings.connection_mode, plan_settings.parallel_grow_enabled, plan_settings.informed_sampling_enabled, rng.fork(RngPurpose::SAMPLE));
+        }
+        timing.grow.record();
+
+        path = extractPath(tree.pool, tree.pathEnd());
+    }
+
+    void planRrtx(const Problem& problem, const PlanSettings& plan_settings, const ActionSettings& action_settings, const bool mode_changed, const Rng& rng) {
+        const ProblemEdits& problem_edits = action_settings.problem_edits;
+
+        // The graph is rooted at the goal, so moving the goal starts over.
+        timing.cull.start();
+        if (action_settings.tree_edits.should_reset || mode_changed || problem_edits.goal_changed) {
+            rrtx.reset(problem);
+        } else {
+            if (problem_edits.obstacle_added) {
+                rrtx.addObstacles(problem_edits.added_obstacles);
+            }
+            if (problem_edits.obstacle_removed) {
+                rrtx.removeObstacles(problem_edits.removed_obstacles, problem.obstacle_grid);
+            }
+            if (problem_edits.start_changed) {
+                rrtx.moveStart(problem);
+            }
+        }
+        rrtx.propagate();
+        timing.cull.record();
+
+        // Nothing is carried: the graph keeps every node.
+        timing.carry.start();
+        timing.carry.record();
+
+        timing.grow.start();
+        if (action_settings.tree_edits.should_grow) {
+            rrtx.grow(problem, plan_settings.num_samples, plan_settings.informed_sampling_enabled, rng.fork(RngPurpose::SAMPLE));
         }
         timing.grow.record();
 
-        path = extractPath(tree.nodes, problem);
+        path = rrtx.extractPath();
     }
 
     void prep(const Problem& problem, const PlanSettings& plan_settings) {
-        tree.reset(problem.start);
+        tree.reset(problem);
 
         static constexpr bool start_changed = false;
+        static constexpr bool goal_changed = false;
         static constexpr bool obstacle_added = false;
-        static constexpr ProblemEdits problem_edits = {start_changed, obstacle_added};
+        static constexpr bool obstacle_removed = false;
+        const ProblemEdits problem_edits = {start_changed, goal_changed, obstacle_added, obstacle_removed, {}, {}};
 
         static constexpr bool tree_should_reset = false;
         static constexpr bool tree_should_grow = true;
         static constexpr TreeEdits tree_edits = {tree_should_reset, tree_should_grow};
 
-        static constexpr ActionSettings action_settings = {problem_edits, tree_edits};
+        const ActionSettings action_settings = {problem_edits, tree_edits};
 
         for (int i = 0; i < NUM_PREP_ITERATIONS; ++i) {
             plan(problem, plan_settings, action_settings);
@@ -0,0 +1,375 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "core/geometry.h"
+#include "core/math.h"
+#include "core/obstacle.h"
+#include "core/obstacle_grid.h"
+#include "core/rng.h"
+#include "planner/cost.h"
+#include "planner/informed_set.h"
+#include "planner/node.h"
+#include "planner/node_grid.h"
+#include "planner/path.h"
+#include "planner/sampling.h"
+#include "planner/tree.h"
+
+static constexpr float RRTX_INFINITE_COST = std::numeric_limits<float>::infinity();
+
+// Link to a graph neighbor. The cost is infinite while an obstacle blocks the edge.
+// Each link knows the index of its twin in the neighbor's list, so both directions are updated together.
+struct RrtxEdge {
+    NodeId node;
+    std::uint32_t twin;
+    float cost;
+};
+
+using RrtxEdges = std::vector<RrtxEdge>;
+
+// Queue entries are keyed by the smaller of a node's cost-to-goal and its lookahead. An entry is stale once the node has
+// been requeued under another key or settled, and is skipped when popped.
+using RrtxQueueEntry = std::pair<float, NodeId>;
+using RrtxQueue = std::priority_queue<RrtxQueueEntry, std::vector<RrtxQueueEntry>, std::greater<RrtxQueueEntry>>;
+
+// RRTX-style planner: a graph linking all nodes within RRTX_NEIGHBOR_RADIUS, over which a shortest-path subtree rooted
+// at the goal is kept up to date incrementally. Obstacle edits only change the cost of the edges they touch; nodes whose
+// cost those changes affect are queued as inconsistent and settled cheapest first, stopping as soon as no queued node
+// can lie on a cheaper path from the start. Replanning work therefore scales with the part of the tree the edit affects.
+//
+// Costs run from the goal: pool.cost_to_come holds each node's cost-to-goal and pool.parent its next hop toward the goal.
+// Child lists are not maintained, and nodes are never removed short of a reset; only the start's own node ever moves.
+struct RrtxTree {
+    NodePool pool;
+    NodeIds nodes;
+    NodeGrid grid;
+    std::vector<RrtxEdges> neighbors;
+
+    // Cost-to-goal through the best neighbor. A node is consistent when this equals its cost-to-goal.
+    std::vector<float> lookahead;
+
+    RrtxQueue queue;
+    // Key a node is currently queued under, or infinity if it is not queued.
+    std::vector<float> queued_key;
+
+    Vector2 goal;
+    Vector2 start;
+    NodeId start_node = NULL_NODE;
+
+    // Node added for the start, moved along with it rather than adding one per move, so start moves never grow the graph.
+    // The start may rest on another node instead when it lands exactly on one.
+    NodeId start_own_node = NULL_NODE;
+
+    NodeId root() const {
+        return nodes.front();
+    }
+
+    float costToGoal(const NodeId node) const {
+        return pool.cost_to_come[node];
+    }
+
+    bool isQueued(const NodeId node) const {
+        return queued_key[node] != RRTX_INFINITE_COST;
+    }
+
+    bool startReached() const {
+        return std::isfinite(costToGoal(start_node));
+    }
+
+    float bestCost() const {
+        return costToGoal(start_node);
+    }
+
+    // Mean number of nodes each node is linked to. Every link is counted from both ends.
+    float meanDegree() const {
+        std::size_t num_links = 0;
+        for (const NodeId node : nodes) {
+            num_links += neighbors[node].size();
+        }
+        return static_cast<float>(num_links) / nodes.size();
+    }
+
+    // The graph grows from the goal toward the start, so the informed set is the same ellipse with its foci swapped.
+    InformedSet informedSet(const bool informed_enabled) const {
+        return makeInformedSet(goal, start, informed_enabled ? bestCost() : RRTX_INFINITE_COST);
+    }
+
+    // Path from the goal to the start node, or just the goal if the start is not connected.
+    Path extractPath() const {
+        return startReached() ? ::extractPath(pool, start_node) : Path{root()};
+    }
+
+    // Add a node linked to the given neighbors, which must all be within RRTX_NEIGHBOR_RADIUS.
+    NodeId addNode(const Vector2 pos, const std::vector<std::pair<NodeId, float>>& links) {
+        const NodeId node = pool.add(pos, RRTX_INFINITE_COST, NULL_NODE);
+        nodes.push_back(node);
+        grid.insert(node, pos);
+        neighbors.emplace_back();
+        lookahead.push_back(RRTX_INFINITE_COST);
+        queued_key.push_back(RRTX_INFINITE_COST);
+        link(node, links);
+        return node;
+    }
+
+    void link(const NodeId node, const std::vector<std::pair<NodeId, float>>& links) {
+        for (const auto& [neighbor, cost] : links) {
+            const std::uint32_t twin = static_cast<std::uint32_t>(neighbors[neighbor].size());
+            neighbors[node].push_back({neighbor, twin, cost});
+            neighbors[neighbor].push_back({node, static_cast<std::uint32_t>(neighbors[node].size() - 1), cost});
+        }
+    }
+
+    // Move a node to pos with fresh links, leaving every node that routed through it to find a new parent.
+    void moveNode(const NodeId node, const Vector2 pos, const ObstacleGrid& obstacle_grid) {
+        NodeIds orphaned_nodes;
+        for (const RrtxEdge& edge : neighbors[node]) {
+            if (pool.parent[edge.node] == node) {
+                orphaned_nodes.push_back(edge.node);
+            }
+
+            // Drop the twin by moving the neighbor's last link into its place.
+            RrtxEdges& twin_edges = neighbors[edge.node];
+            const RrtxEdge moved_edge = twin_edges.back();
+            twin_edges[edge.twin] = moved_edge;
+            neighbors[moved_edge.node][moved_edge.twin].twin = edge.twin;
+            twin_edges.pop_back();
+        }
+        neighbors[node].clear();
+
+        grid.remove(node, pool.pos[node]);
+        pool.pos[node] = pos;
+        pool.cost_to_come[node] = RRTX_INFINITE_COST;
+        pool.parent[node] = NULL_NODE;
+        lookahead[node] = RRTX_INFINITE_COST;
+        queued_key[node] = RRTX_INFINITE_COST;
+        link(node, findLinks(pos, obstacle_grid));
+        grid.insert(node, pos);
+
+        for (const NodeId orphaned_node : orphaned_nodes) {
+            updateLookahead(orphaned_node);
+        }
+        updateLookahead(node);
+    }
+
+    // Links from pos to every node within RRTX_NEIGHBOR_RADIUS, blocked ones included so they can reopen later.
+    std::vector<std::pair<NodeId, float>> findLinks(const Vector2 pos, const ObstacleGrid& obstacle_grid) const {
+        std::vector<std::pair<NodeId, float>> links;
+        grid.forEachWithin(pos, RRTX_NEIGHBOR_RADIUS, [&](const NodeId neighbor, const float dist) {
+            const bool blocked = edgeCollides(pos, pool.pos[neighbor], obstacle_grid);
+            links.push_back({neighbor, blocked ? RRTX_INFINITE_COST : dist});
+        });
+        return links;
+    }
+
+    void setEdgeCost(RrtxEdge& edge, const float cost) {
+        edge.cost = cost;
+        neighbors[edge.node][edge.twin].cost = cost;
+    }
+
+    // Queue the node if it is inconsistent, under its current key; dequeue it otherwise.
+    void updateQueue(const NodeId node) {
+        const float cost = costToGoal(node);
+        if (cost == lookahead[node]) {
+            queued_key[node] = RRTX_INFINITE_COST;
+            return;
+        }
+        const float key = std::min(cost, lookahead[node]);
+        if (key != queued_key[node]) {
+            queued_key[node] = key;
+            queue.push({key, node});
+        }
+    }
+
+    // Recompute the lookahead and parent of a node from all its neighbors.
+    void updateLookahead(const NodeId node) {
+        if (node == root()) {
+            return;
+        }
+        float best_cost = RRTX_INFINITE_COST;
+        NodeId best_parent = NULL_NODE;
+        for (const RrtxEdge& edge : neighbors[node]) {
+            const float cost = edge.cost + costToGoal(edge.node);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_parent = edge.node;
+            }
+        }
+        lookahead[node] = best_cost;
+        pool.parent[node] = best_parent;
+        updateQueue(node);
+    }
+
+    // Offer a node a cheaper route through the given parent.
+    void relax(const NodeId node, const NodeId parent, const float cost) {
+        if ((node == root()) || (cost >= lookahead[node])) {
+            return;
+        }
+        lookahead[node] = cost;
+        pool.parent[node] = parent;
+        updateQueue(node);
+    }
+
+    void reset(const Problem& problem) {
+        pool.clear();
+        nodes.clear();
+        grid.clear();
+        neighbors.clear();
+        lookahead.clear();
+        queued_key.clear();
+        queue = {};
+        start_own_node = NULL_NODE;
+
+        goal = problem.goal;
+        const NodeId root_node = addNode(goal, {});
+        pool.cost_to_come[root_node] = 0.0f;
+        lookahead[root_node] = 0.0f;
+
+        moveStart(problem);
+    }
+
+    // The start gets a node of its own, linked like any other, which follows it on later moves.
+    // A start that lands exactly on a node rests on it instead, since a zero-length edge would let two nodes route through
+    // each other.
+    void moveStart(const Problem& problem) {
+        start = problem.start;
+        const NodeId nearest = getNearest(start, grid);
+        if ((nearest != NULL_NODE) && (Vector2DistanceSqr(pool.pos[nearest], start) == 0.0f)) {
+            start_node = nearest;
+            return;
+        }
+        if (start_own_node != NULL_NODE) {
+            moveNode(start_own_node, start, problem.obstacle_grid);
+        } else {
+            start_own_node = addNode(start, findLinks(start, problem.obstacle_grid));
+            updateLookahead(start_own_node);
+        }
+        start_node = start_own_node;
+    }
+
+    // Block every edge that crosses an added obstacle and requeue the nodes whose route used one.
+    void addObstacles(const Obstacles& added_obstacles) {
+        // A blocked edge has its closest point to the obstacle within OBSTACLE_RADIUS of its center,
+        // and one of its endpoints within half an edge length of that point.
+        static constexpr float reach = OBSTACLE_RADIUS + 0.5f * RRTX_NEIGHBOR_RADIUS;
+
+        NodeIds affected_nodes;
+        for (const Obstacle obstacle : added_obstacles) {
+            grid.forEachWithin(obstacle, reach, [&](const NodeId node, const float) {
+                for (RrtxEdge& edge : neighbors[node]) {
+                    if (!std::isfinite(edge.cost) || !segmentCollides(pool.pos[node], pool.pos[edge.node], obstacle)) {
+                        continue;
+                    }
+                    setEdgeCost(edge, RRTX_INFINITE_COST);
+                    if (pool.parent[node] == edge.node) {
+                        affected_nodes.push_back(node);
+                    }
+                    if (pool.parent[edge.node] == node) {
+                        affected_nodes.push_back(edge.node);
+                    }
+                }
+            });
+        }
+        for (const NodeId node : affected_nodes) {
+            updateLookahead(node);
+        }
+    }
+
+    // Reopen every blocked edge that crossed a removed obstacle and no longer hits any other, offering both ends the shortcut.
+    void removeObstacles(const Obstacles& removed_obstacles, const ObstacleGrid& obstacle_grid) {
+        static constexpr float reach = OBSTACLE_RADIUS + 0.5f * RRTX_NEIGHBOR_RADIUS;
+
+        for (const Obstacle obstacle : removed_obstacles) {
+            grid.forEachWithin(obstacle, reach, [&](const NodeId node, const float) {
+                for (RrtxEdge& edge : neighbors[node]) {
+                    const Vector2 a = pool.pos[node];
+                    const Vector2 b = pool.pos[edge.node];
+                    if (std::isfinite(edge.cost) || !segmentCollides(a, b, obstacle) || edgeCollides(a, b, obstacle_grid)) {
+                        continue;
+                    }
+                    const float cost = computeCost(a, b);
+                    setEdgeCost(edge, cost);
+                    relax(node, edge.node, cost + costToGoal(edge.node));
+                    relax(edge.node, node, cost + costToGoal(node));
+                }
+            });
+        }
+    }
+
+    // Settle queued nodes cheapest first until the start is consistent and no queued node can be on a cheaper path from it.
+    // A node whose lookahead dropped takes it as its cost and offers the drop to its neighbors. A node whose lookahead rose
+    // gives up its cost entirely, so every node routed through it looks for a new parent, and is queued again to settle later.
+    void propagate() {
+        while (!queue.empty()) {
+            const auto [key, node] = queue.top();
+            if (queued_key[node] != key) {
+                queue.pop();
+                continue;
+            }
+            if (!isQueued(start_node) && (key >= costToGoal(start_node))) {
+                break;
+            }
+            queue.pop();
+            queued_key[node] = RRTX_INFINITE_COST;
+
+            if (costToGoal(node) > lookahead[node]) {
+                pool.cost_to_come[node] = lookahead[node];
+                for (const RrtxEdge& edge : neighbors[node]) {
+                    relax(edge.node, node, edge.cost + costToGoal(node));
+                }
+            } else {
+                pool.cost_to_come[node] = RRTX_INFINITE_COST;
+                updateQueue(node);
+                for (const RrtxEdge& edge : neighbors[node]) {
+                    if (pool.parent[edge.node] == node) {
+                        updateLookahead(edge.node);
+                    }
+                }
+            }
+        }
+    }
+
+    // Steer the sample to within linking distance of its nearest node and link it into the graph.
+    // Samples that would have no unblocked link are discarded.
+    void extend(Vector2 pos, const ObstacleGrid& obstacle_grid) {
+        const Vector2 nearest_pos = pool.pos[getNearest(pos, grid)];
+        const float dist = Vector2Distance(nearest_pos, pos);
+        if (dist == 0.0f) {
+            return;
+        }
+        pos = Vector2Add(nearest_pos, (pos - nearest_pos) * (std::min(dist, RRTX_NEIGHBOR_RADIUS) / dist));
+        if (!insideEnvironment(pos) || collides(pos, obstacle_grid)) {
+            return;
+        }
+
+        const std::vector<std::pair<NodeId, float>> links = findLinks(pos, obstacle_grid);
+        if (std::none_of(links.begin(), links.end(), [](const auto& link) { return std::isfinite(link.second); })) {
+            return;
+        }
+        updateLookahead(addNode(pos, links));
+    }
+
+    bool isFull() const {
+        return static_cast<int>(nodes.size()) >= RRTX_NUM_NODES_MAX;
+    }
+
+    // Grow the graph by up to num_samples samples, stopping once it is full.
+    // Costs are propagated after each batch so the informed set tracks the current solution.
+    void grow(const Problem& problem, const int num_samples, const bool informed_enabled, const Rng& rng) {
+        SampleBatch samples;
+        for (int num_grown = 0; (num_grown < num_samples) && !isFull(); num_grown += GROW_BATCH_SIZE_MAX) {
+            const int batch_size = std::min(GROW_BATCH_SIZE_MAX, num_samples - num_grown);
+            fillSamples(start, informedSet(informed_enabled), rng, num_grown, batch_size, samples);
+            for (int i = 0; (i < batch_size) && !isFull(); ++i) {
+                extend(samples.at(i), problem.obstacle_grid);
+            }
+            propagate();
+        }
+    }
+};
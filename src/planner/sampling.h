@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "config.h"
+#include "core/geometry.h"
+#include "core/math.h"
+#include "core/rng.h"
+#include "planner/informed_set.h"
+
+// Samples are generated a batch at a time. The first pass is straight-line arithmetic per lane so the compiler can
+// vectorize it: counter-based random draws, polar transforms and the region test. Lanes that are goal-biased or fall
+// outside the region are flagged and finished by a short scalar pass.
+// Sample i depends only on the stream and its index, never on batch boundaries or thread count.
+
+// Structure-of-arrays sample buffer.
+struct SampleBatch {
+    std::vector<float> xs;
+    std::vector<float> ys;
+    std::vector<std::uint8_t> needs_fixup;
+
+    void resize(const int count) {
+        xs.resize(count);
+        ys.resize(count);
+        needs_fixup.resize(count);
+    }
+
+    Vector2 at(const int i) const {
+        return {xs[i], ys[i]};
+    }
+};
+
+// Where non-goal samples are drawn from.
+enum class SampleRegion {
+    ENVIRONMENT,
+    INFORMED_SET,
+    ENVIRONMENT_IN_INFORMED_SET,
+};
+
+// sin(2 * pi * v) for v in [-0.5, 0.5], folded into [-pi/2, pi/2] for an odd Taylor polynomial accurate to about 1e-7.
+// Folds and wraps use min/max and arithmetic instead of branches so the lane loop vectorizes.
+inline float sinTurns(const float v) {
+    const float v_upper = std::min(v, 0.5f - v);
+    const float w = std::max(v_upper, -0.5f - v_upper);
+    const float x = 2.0f * static_cast<float>(M_PI) * w;
+    const float x2 = x * x;
+    return x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f + x2 * (1.0f / 362880.0f + x2 * (-1.0f / 39916800.0f))))));
+}
+
+// Sine and cosine of 2 * pi * u for u in [0, 1).
+inline void sinCosTurns(const float u, float& s, float& c) {
+    // 2 * pi * u = 2 * pi * v + pi, and cos(2 * pi * v) = sin(2 * pi * (0.25 - |v|)).
+    const float v = u - 0.5f;
+    s = -sinTurns(v);
+    c = -sinTurns(0.25f - std::abs(v));
+}
+
+// The larger of two uniform draws is distributed like the square root of one, which gives a uniform disk radius
+// without a square root.
+inline Vector2 diskToEllipse(const InformedSet& informed_set, const float u_r, const float u_r_other, const float u_t) {
+    float s;
+    float c;
+    sinCosTurns(u_t, s, c);
+    const float r = std::max(u_r, u_r_other);
+    const float u = informed_set.semi_major * r * c;
+    const float v = informed_set.semi_minor * r * s;
+    const Vector2 axis = informed_set.axis;
+    return {informed_set.center.x + u * axis.x - v * axis.y, informed_set.center.y + u * axis.y + v * axis.x};
+}
+
+inline Vector2 unitToEnvironment(const float u_x, const float u_y) {
+    return {ENVIRONMENT_X_MIN + u_x * ENVIRONMENT_WIDTH, ENVIRONMENT_Y_MIN + u_y * ENVIRONMENT_HEIGHT};
+}
+
+inline Vector2 diskToGoal(const Vector2 goal, const float u_r, const float u_t) {
+    float s;
+    float c;
+    sinCosTurns(u_t, s, c);
+    const float r = GOAL_RADIUS * u_r;
+    const float x = std::min(std::max(goal.x + r * c, static_cast<float>(ENVIRONMENT_X_MIN)), static_cast<float>(ENVIRONMENT_X_MAX));
+    const float y = std::min(std::max(goal.y + r * s, static_cast<float>(ENVIRONMENT_Y_MIN)), static_cast<float>(ENVIRONMENT_Y_MAX));
+    return {x, y};
+}
+
+// Same test as insideEnvironment, without short-circuiting so it stays branch-free.
+inline bool laneInsideEnvironment(const Vector2 pos) {
+    return (ENVIRONMENT_X_MIN < pos.x) & (pos.x < ENVIRONMENT_X_MAX) & (ENVIRONMENT_Y_MIN < pos.y) & (pos.y < ENVIRONMENT_Y_MAX);
+}
+
+// Draws used per sample: 0 selects goal or region, then three per attempt at the region.
+inline std::uint32_t attemptDraw(const int attempt) {
+    return 1 + 3 * attempt;
+}
+
+// First region attempt for every lane. Goal-biased lanes and lanes that fell outside the region are flagged.
+template <SampleRegion region>
+void fillSampleLanes(const InformedSet& informed_set, const Rng& rng, const std::uint32_t first_index, const int count, SampleBatch& batch) {
+    float* xs = batch.xs.data();
+    float* ys = batch.ys.data();
+    std::uint8_t* needs_fixup = batch.needs_fixup.data();
+
+    for (int i = 0; i < count; ++i) {
+        const std::uint32_t index = first_index + i;
+        const float u_select = rng.uniformAt(index, 0);
+        const float u_0 = rng.uniformAt(index, attemptDraw(0));
+        const float u_1 = rng.uniformAt(index, attemptDraw(0) + 1);
+
+        Vector2 pos;
+        bool accepted = true;
+        if constexpr (region == SampleRegion::ENVIRONMENT) {
+            pos = unitToEnvironment(u_0, u_1);
+        } else if constexpr (region == SampleRegion::INFORMED_SET) {
+            pos = diskToEllipse(informed_set, u_0, rng.uniformAt(index, attemptDraw(0) + 2), u_1);
+            accepted = laneInsideEnvironment(pos);
+        } else {
+            pos = unitToEnvironment(u_0, u_1);
+            accepted = informed_set.contains(pos);
+        }
+
+        xs[i] = pos.x;
+        ys[i] = pos.y;
+        needs_fixup[i] = (u_select < GOAL_SAMPLE_PROBABILITY) | !accepted;
+    }
+}
+
+// Finish a flagged lane: draw near the goal, or redraw until the sample lands in the region,
+// falling back to a uniform environment sample.
+inline Vector2 fixupSample(const Vector2 goal, const InformedSet& informed_set, const SampleRegion region, const Rng& rng, const std::uint32_t index) {
+    if (rng.uniformAt(index, 0) < GOAL_SAMPLE_PROBABILITY) {
+        return diskToGoal(goal, rng.uniformAt(index, attemptDraw(0)), rng.uniformAt(index, attemptDraw(0) + 1));
+    }
+
+    for (int attempt = 1; attempt < INFORMED_SAMPLE_ATTEMPTS_MAX; ++attempt) {
+        const float u_0 = rng.uniformAt(index, attemptDraw(attempt));
+        const float u_1 = rng.uniformAt(index, attemptDraw(attempt) + 1);
+        if (region == SampleRegion::INFORMED_SET) {
+            const Vector2 pos = diskToEllipse(informed_set, u_0, rng.uniformAt(index, attemptDraw(attempt) + 2), u_1);
+            if (insideEnvironment(pos)) {
+                return pos;
+            }
+        } else {
+            const Vector2 pos = unitToEnvironment(u_0, u_1);
+            if (informed_set.contains(pos)) {
+                return pos;
+            }
+        }
+    }
+
+    return unitToEnvironment(rng.uniformAt(index, attemptDraw(INFORMED_SAMPLE_ATTEMPTS_MAX)), rng.uniformAt(index, attemptDraw(INFORMED_SAMPLE_ATTEMPTS_MAX) + 1));
+}
+
+// Fill the batch with samples first_index .. first_index + count - 1 of the stream.
+// Most samples are uniform over the informed set intersected with the environment; a few are drawn near the goal.
+inline void fillSamples(const Vector2 goal, const InformedSet& informed_set, const Rng& rng, const std::uint32_t first_index, const int count, SampleBatch& batch) {
+    batch.resize(count);
+
+    // Draw from whichever of the informed set and the environment is smaller, rejecting draws outside the other.
+    SampleRegion region = SampleRegion::ENVIRONMENT;
+    if (informed_set.isBounded()) {
+        region = (informed_set.coverage() < 1.0f) ? SampleRegion::INFORMED_SET : SampleRegion::ENVIRONMENT_IN_INFORMED_SET;
+    }
+
+    switch (region) {
+        case SampleRegion::ENVIRONMENT:
+            fillSampleLanes<SampleRegion::ENVIRONMENT>(informed_set, rng, first_index, count, batch);
+            break;
+        case SampleRegion::INFORMED_SET:
+            fillSampleLanes<SampleRegion::INFORMED_SET>(informed_set, rng, first_index, count, batch);
+            break;
+        case SampleRegion::ENVIRONMENT_IN_INFORMED_SET:
+            fillSampleLanes<SampleRegion::ENVIRONMENT_IN_INFORMED_SET>(informed_set, rng, first_index, count, batch);
+            break;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        if (batch.needs_fixup[i]) {
+            const Vector2 pos = fixupSample(goal, informed_set, region, rng, first_index + i);
+            batch.xs[i] = pos.x;
+            batch.ys[i] = pos.y;
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+
+#include "planner/node.h"
+
+// Iterative depth-first walks over the child lists of a subtree. The explicit stack is kept between walks,
+// so deep corridor branches neither grow the call stack nor reallocate once the buffer has grown.
+// Visitors may change node data but not the child lists of the subtree being walked.
+struct SubtreeWalker {
+    NodeIds stack;
+
+    // Visit node and its descendants, each parent before its children and siblings in child-list order.
+    // Returning false from visit skips the descendants of the visited node.
+    template <typename Visitor>
+    void preorder(const NodePool& pool, const NodeId node, Visitor&& visit) {
+        stack.clear();
+        stack.push_back(node);
+        while (!stack.empty()) {
+            const NodeId current = stack.back();
+            stack.pop_back();
+            if (!visit(current)) {
+                continue;
+            }
+
+            // Push children reversed so the first child is visited first.
+            const std::size_t num_pending = stack.size();
+            for (NodeId child = pool.first_child[current]; child != NULL_NODE; child = pool.next_sibling[child]) {
+                stack.push_back(child);
+            }
+            std::reverse(stack.begin() + num_pending, stack.end());
+        }
+    }
+
+    // Visit node and its descendants, each parent after all of its children. The stack holds the ancestors of the
+    // node being visited, up to node itself.
+    template <typename Visitor>
+    void postorder(const NodePool& pool, const NodeId node, Visitor&& visit) {
+        stack.clear();
+        NodeId current = node;
+        while (true) {
+            while (pool.first_child[current] != NULL_NODE) {
+                stack.push_back(current);
+                current = pool.first_child[current];
+            }
+
+            // Climb until a node with an unvisited sibling, visiting on the way.
+            while (true) {
+                visit(current);
+                if (stack.empty()) {
+                    return;
+                }
+                if (pool.next_sibling[current] != NULL_NODE) {
+                    current = pool.next_sibling[current];
+                    break;
+                }
+                current = stack.back();
+                stack.pop_back();
+            }
+        }
+    }
+};
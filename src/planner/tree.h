@@ -1,238 +1,416 @@
 #pragma once
 
-#include <raylib.h>
-#include <raymath.h>
-
 #include <algorithm>
-#include <memory>
-#include <random>
-
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+
+#include "core/carry_policy.h"
+#include "core/connection_mode.h"
 #include "core/geometry.h"
+#include "core/math.h"
 #include "core/obstacle.h"
+#include "core/obstacle_grid.h"
 #include "core/rng.h"
+#include "core/thread_pool.h"
 #include "planner/cost.h"
+#include "planner/edge_grid.h"
+#include "planner/informed_set.h"
 #include "planner/node.h"
+#include "planner/node_grid.h"
 #include "planner/path.h"
+#include "planner/sampling.h"
+#include "planner/subtree_walker.h"
 
-bool edgeCollides(const Vector2 start, const Vector2 goal, const Obstacles& obstacles) {
-    static constexpr float LERP_DEN = NUM_INTERMEDIATE_COLLISION_CHECK_POINTS - 1;
-    for (int i = 0; i < NUM_INTERMEDIATE_COLLISION_CHECK_POINTS; ++i) {
-        const float t = float(i) / LERP_DEN;
-        if (collides(Vector2Lerp(start, goal, t), obstacles)) {
-            return true;
-        }
-    }
-    return false;
+inline bool edgeCollides(const Vector2 start, const Vector2 goal, const ObstacleGrid& obstacle_grid) {
+    return segmentCollides(start, goal, obstacle_grid);
 }
 
-bool edgeCollides(const NodePtr& node, const Obstacles& obstacles) {
-    return (node->parent) ? edgeCollides(node->parent->pos, node->pos, obstacles) : collides(node->pos, obstacles);
+inline bool edgeCollides(const NodePool& pool, const NodeId node, const ObstacleGrid& obstacle_grid) {
+    return pool.hasParent(node) ? edgeCollides(pool.pos[pool.parent[node]], pool.pos[node], obstacle_grid) : collides(pool.pos[node], obstacle_grid);
 }
 
-struct TargetDistanceComparator {
+struct TargetCostComparatorInv {
+    const NodePool& pool;
     Vector2 target;
 
-    bool operator()(const NodePtr& a, const NodePtr& b) const {
-        return computeCost(a->pos, target) < computeCost(b->pos, target);
+    bool operator()(const NodeId a, const NodeId b) const {
+        return pool.estimateCostTo(a, target) > pool.estimateCostTo(b, target);
     }
 };
 
-struct TargetCostComparator {
-    Vector2 target;
+inline NodeId getNearest(const Vector2 target, const NodeGrid& grid) {
+    return grid.nearest(target);
+}
 
-    bool operator()(const NodePtr& a, const NodePtr& b) const {
-        return a->estimateCostTo(target) < b->estimateCostTo(target);
-    }
+enum class EdgeStatus : std::uint8_t {
+    UNCHECKED,
+    FREE,
+    BLOCKED
 };
 
-struct TargetCostComparatorInv {
-    Vector2 target;
-
-    bool operator()(const NodePtr& a, const NodePtr& b) const {
-        return a->estimateCostTo(target) > b->estimateCostTo(target);
-    }
+// A node near a query position, with its distance and, once checked, whether the edge between them is collision-free.
+struct Neighbor {
+    NodeId node;
+    float dist;
+    EdgeStatus edge;
 };
 
-NodePtr getNearest(const Vector2 target, const Nodes& nodes) {
-    return *std::min_element(nodes.begin(), nodes.end(), TargetDistanceComparator{target});
-}
+using Neighborhood = std::vector<Neighbor>;
 
-NodePtr getCheapest(const Vector2 target, const Nodes& nodes) {
-    return *std::min_element(nodes.begin(), nodes.end(), TargetCostComparator{target});
+// Every node within max_dist of target, edges unchecked.
+inline void queryNeighborhood(const Vector2 target, const NodeGrid& grid, const float max_dist, Neighborhood& neighborhood) {
+    neighborhood.clear();
+    grid.forEachWithin(target, max_dist, [&](const NodeId node, const float dist) { neighborhood.push_back({node, dist, EdgeStatus::UNCHECKED}); });
 }
 
-Nodes getNeighbors(const Vector2 target, const Nodes& nodes, const Obstacles& obstacles, const float max_dist) {
-    Nodes neighbors;
-    for (const NodePtr& node : nodes) {
-        const float dist = Vector2Distance(node->pos, target);
-        if (dist > max_dist) {
-            continue;
-        }
+// Limits on the neighborhood a new node connects to.
+struct ConnectionRange {
+    float radius;
+    int num_neighbors_max;
+};
 
-        const bool in_collision = (dist < MAX_DISTANCE_BETWEEN_POSES_FOR_COLLISION_CHECK) ? collides(node->pos, obstacles) : edgeCollides(node->pos, target, obstacles);
-        if (in_collision) {
-            continue;
-        }
+// Connection limits for a tree of num_nodes nodes. The adaptive modes never reach past REWIRE_RADIUS, which bounds
+// the grid query and keeps small trees connected as before.
+inline ConnectionRange computeConnectionRange(const ConnectionMode mode, const std::size_t num_nodes) {
+    const float n = static_cast<float>(std::max<std::size_t>(num_nodes, 2));
+    const float log_n = std::log(n);
+    switch (mode) {
+        case ConnectionMode::SHRINKING_RADIUS:
+            return {std::min(REWIRE_RADIUS, std::sqrt(CONNECTION_RADIUS_GAMMA_SQR * log_n / n)), std::numeric_limits<int>::max()};
+        case ConnectionMode::K_NEAREST:
+            return {REWIRE_RADIUS, static_cast<int>(std::ceil(CONNECTION_K_FACTOR * log_n))};
+        default:
+            return {REWIRE_RADIUS, std::numeric_limits<int>::max()};
+    }
+}
 
-        neighbors.push_back(node);
+// The nodes within range of target, keeping only the nearest when there are too many.
+// A neighbor count limit searches the grid ring by ring and stops once enough nodes are closer than any cell left
+// unsearched, so only as many rings are searched as the k-th nearest node needs.
+inline void queryNeighborhood(const Vector2 target, const NodeGrid& grid, const ConnectionRange range, Neighborhood& neighborhood) {
+    if (range.num_neighbors_max == std::numeric_limits<int>::max()) {
+        queryNeighborhood(target, grid, range.radius, neighborhood);
+        return;
+    }
+
+    const std::size_t k = static_cast<std::size_t>(range.num_neighbors_max);
+    neighborhood.clear();
+    grid.forEachWithinByRing(
+        target, range.radius, [&](const NodeId node, const float dist) { neighborhood.push_back({node, dist, EdgeStatus::UNCHECKED}); },
+        [&](const float reach) {
+            if (neighborhood.size() < k) {
+                return false;
+            }
+            const auto num_within_reach = std::count_if(neighborhood.begin(), neighborhood.end(), [&](const Neighbor& neighbor) { return neighbor.dist <= reach; });
+            return static_cast<std::size_t>(num_within_reach) >= k;
+        });
+
+    if (neighborhood.size() > k) {
+        const auto nearest_end = neighborhood.begin() + k;
+        std::nth_element(neighborhood.begin(), nearest_end, neighborhood.end(), [](const Neighbor& a, const Neighbor& b) { return a.dist < b.dist; });
+        neighborhood.erase(nearest_end, neighborhood.end());
     }
-    return neighbors;
 }
 
-NodePtr getParent(const Vector2 target, const Nodes& nodes, const Obstacles& obstacles, const float max_dist) {
-    const Nodes neighbors = getNeighbors(target, nodes, obstacles, max_dist);
+// Cheapest neighbor with a free edge to target, or NULL_NODE if there is none. Neighbors are taken in order of
+// cost through them and checked only until one is free, so the edges of pricier neighbors are left unchecked.
+inline NodeId getCheapest(const Vector2 target, const NodePool& pool, const ObstacleGrid& obstacle_grid, Neighborhood& neighborhood) {
+    while (true) {
+        Neighbor* cheapest = nullptr;
+        float cheapest_cost = std::numeric_limits<float>::infinity();
+        for (Neighbor& neighbor : neighborhood) {
+            const float cost = pool.cost_to_come[neighbor.node] + neighbor.dist;
+            if ((neighbor.edge != EdgeStatus::BLOCKED) && (cost < cheapest_cost)) {
+                cheapest = &neighbor;
+                cheapest_cost = cost;
+            }
+        }
 
-    if (neighbors.empty()) {
-        return getNearest(target, nodes);
+        if (cheapest == nullptr) {
+            return NULL_NODE;
+        }
+        if (cheapest->edge == EdgeStatus::UNCHECKED) {
+            cheapest->edge = edgeCollides(pool.pos[cheapest->node], target, obstacle_grid) ? EdgeStatus::BLOCKED : EdgeStatus::FREE;
+        }
+        if (cheapest->edge == EdgeStatus::FREE) {
+            return cheapest->node;
+        }
     }
+}
 
-    return getCheapest(target, neighbors);
+inline NodeId getParent(const Vector2 target, const NodePool& pool, const NodeGrid& grid, const ObstacleGrid& obstacle_grid, Neighborhood& neighborhood) {
+    const NodeId cheapest = getCheapest(target, pool, obstacle_grid, neighborhood);
+    return (cheapest != NULL_NODE) ? cheapest : getNearest(target, grid);
 }
 
-Path extractPath(const Nodes& nodes, const Problem& problem) {
+inline Path extractPath(const NodePool& pool, const NodeId end_node) {
     Path path;
-    NodePtr node = getParent(problem.goal, nodes, problem.obstacles, GOAL_RADIUS);
-    while (node->parent) {
+    NodeId node = end_node;
+    while (pool.hasParent(node)) {
         path.push_back(node);
-        node = node->parent;
+        node = pool.parent[node];
     }
     path.push_back(node);
     std::reverse(path.begin(), path.end());
     return path;
 }
 
-Vector2 sampleNearGoal(const Vector2 goal) {
-    static std::uniform_real_distribution<float> dist_goal_r(0, GOAL_RADIUS);
-    static std::uniform_real_distribution<float> dist_goal_t(0.0f, 2.0f * M_PI);
-    const float r = dist_goal_r(rng);
-    const float t = dist_goal_t(rng);
-    const Vector2 delta = {r * std::cos(t), r * std::sin(t)};
-    return clampToEnvironment(goal + delta);
-}
-
-Vector2 sampleEnv() {
-    static std::uniform_real_distribution<float> dist_x(ENVIRONMENT_X_MIN, ENVIRONMENT_X_MAX);
-    static std::uniform_real_distribution<float> dist_y(ENVIRONMENT_Y_MIN, ENVIRONMENT_Y_MAX);
-    return Vector2{dist_x(rng), dist_y(rng)};
-}
-
-Vector2 sample(const Vector2 goal) {
-    static std::uniform_real_distribution<float> dist_select(0.0f, 1.0f);
-    return (dist_select(rng) < GOAL_SAMPLE_PROBABILITY) ? sampleNearGoal(goal) : sampleEnv();
-}
-
-Vector2 attractByDistance(const Vector2 pos, const NodePtr parent) {
-    const Vector2 direction = Vector2Normalize(pos - parent->pos);
-    const float distance = std::min(DEVIATION_DISTANCE_MAX, Vector2Distance(parent->pos, pos));
-    return Vector2Add(parent->pos, direction * distance);
+// Positions already within the steering limits are returned unchanged, so an unsteered sample keeps its neighborhood.
+inline Vector2 attractByDistance(const Vector2 pos, const NodePool& pool, const NodeId parent) {
+    const Vector2 parent_pos = pool.pos[parent];
+    const float distance = Vector2Distance(parent_pos, pos);
+    if (distance <= DEVIATION_DISTANCE_MAX) {
+        return pos;
+    }
+    const Vector2 direction = Vector2Normalize(pos - parent_pos);
+    return Vector2Add(parent_pos, direction * DEVIATION_DISTANCE_MAX);
 }
 
-Vector2 attractByAngle(const Vector2 pos, const NodePtr parent) {
-    const Vector2 x = parent->parent ? parent->parent->pos : parent->pos - (pos - parent->pos);
-    const Vector2 y = parent->pos;
+inline Vector2 attractByAngle(const Vector2 pos, const NodePool& pool, const NodeId parent) {
+    const Vector2 parent_pos = pool.pos[parent];
+    const Vector2 x = pool.hasParent(parent) ? pool.pos[pool.parent[parent]] : parent_pos - (pos - parent_pos);
+    const Vector2 y = parent_pos;
     const Vector2 z = pos;
     const Vector2 direction_yz = Vector2Normalize(z - y);
     const Vector2 direction_xy = Vector2Normalize(y - x);
     const float distance_yz = Vector2Distance(y, z);
     const float distance_xy = Vector2Distance(x, y);
     const float deviation_angle_max = std::asin(std::clamp(0.5f * (distance_xy + distance_yz) / RADIUS_OF_CURVATURE_MIN, 0.0f, 1.0f));
-    const float deviation_angle = std::clamp(Vector2Angle(direction_xy, direction_yz), -deviation_angle_max, deviation_angle_max);
+    const float angle = Vector2Angle(direction_xy, direction_yz);
+    if (std::abs(angle) <= deviation_angle_max) {
+        return pos;
+    }
+    const float deviation_angle = std::clamp(angle, -deviation_angle_max, deviation_angle_max);
     const Vector2 direction_out = Vector2Rotate(direction_xy, deviation_angle);
-    return Vector2Add(parent->pos, direction_out * distance_yz);
+    return Vector2Add(parent_pos, direction_out * distance_yz);
 }
 
-bool goalReached(const NodePtr node, const Vector2 goal) {
-    return Vector2Distance(node->pos, goal) < GOAL_RADIUS;
+inline bool goalReached(const Vector2 pos, const Vector2 goal) {
+    return Vector2Distance(pos, goal) < GOAL_RADIUS;
 }
 
-bool goalReached(const Path& path, const Vector2 goal) {
-    return goalReached(path.back(), goal);
+inline bool goalReached(const NodePool& pool, const Path& path, const Vector2 goal) {
+    return goalReached(pool.pos[path.back()], goal);
 }
 
-using ChildMap = std::unordered_map<NodePtr, std::unordered_set<NodePtr>>;
+// A sample steered toward its chosen parent, computed against a read-only tree.
+struct GrowthCandidate {
+    NodeId parent;
+    Vector2 pos;
+    bool valid;
+    // Nodes within the connection range of pos when the candidate was proposed.
+    Neighborhood neighborhood;
+};
+
+struct Tree {
+    NodePool pool;
+    NodeIds nodes;
+    NodeGrid grid;
+    EdgeGrid edge_grid;
+
+    // Goal region: nodes within GOAL_RADIUS of the goal with a collision-free edge to it.
+    // Kept up to date as nodes are inserted, rewired and dropped, so path extraction never searches the tree.
+    Vector2 goal;
+    NodeIds goal_nodes;
+    std::vector<bool> is_goal_node;
+    NodeId best_goal_node = NULL_NODE;
+
+    // Scratch marks for carry and retain.
+    NodeMarks retained;
+
+    // Scratch map from old to new handles for retain.
+    NodeIds new_ids;
+
+    // Scratch marks and list of the nodes dropped by cullByObstacles.
+    NodeMarks culled;
+    NodeIds culled_nodes;
+
+    // Scratch stack for subtree walks.
+    SubtreeWalker walker;
+
+    // Rewired nodes whose descendants still hold their old cost-to-come. Growth resolves them in one pass per batch
+    // instead of walking each rewired subtree as it happens; until then, costs below them are upper bounds,
+    // and resolvedCost gives the exact cost of a single node.
+    NodeIds stale_roots;
+    NodeMarks is_stale_root;
+
+    // Scratch path to the root for resolvedCost.
+    NodeIds cost_chain;
 
-inline ChildMap buildChildMap(const Nodes& nodes) {
-    ChildMap child_map;
-    for (const NodePtr& node : nodes) {
-        if (node->parent) {
-            child_map[node->parent].insert(node);
+    // Scratch candidate for growOnce.
+    GrowthCandidate growth_candidate;
+
+    // Neighbors gathered by the nodes added in the current grow, and the mean per node over the last grow that added any.
+    std::size_t num_neighbors_grown = 0;
+    float mean_neighborhood_size = 0.0f;
+
+    // Number of carries so far, and the carry count when each node was added. A node's age is the number of carries it has survived.
+    std::uint32_t generation = 0;
+    std::vector<std::uint32_t> birth_generation;
+
+    NodeId root() const {
+        return nodes.front();
+    }
+
+    // Cheapest node in the goal region, or the node nearest the goal if none reaches it.
+    NodeId pathEnd() const {
+        return (best_goal_node != NULL_NODE) ? best_goal_node : getNearest(goal, grid);
+    }
+
+    float bestCost() const {
+        return (best_goal_node != NULL_NODE) ? pool.estimateCostTo(best_goal_node, goal) : std::numeric_limits<float>::infinity();
+    }
+
+    // Region worth sampling: bounded by the best solution cost when informed sampling is enabled, unbounded otherwise.
+    InformedSet informedSet(const bool informed_enabled) const {
+        return makeInformedSet(pool.pos[root()], goal, informed_enabled ? bestCost() : std::numeric_limits<float>::infinity());
+    }
+
+    bool inGoalRegion(const NodeId node, const ObstacleGrid& obstacle_grid) const {
+        return goalReached(pool.pos[node], goal) && !edgeCollides(pool.pos[node], goal, obstacle_grid);
+    }
+
+    // Costs only ever decrease between calls to updateBestGoalNode, so comparing against the current best suffices.
+    void considerGoalNode(const NodeId node) {
+        if (!is_goal_node[node]) {
+            return;
+        }
+        if ((best_goal_node == NULL_NODE) || (pool.estimateCostTo(node, goal) < pool.estimateCostTo(best_goal_node, goal))) {
+            best_goal_node = node;
         }
     }
-    return child_map;
-}
 
-struct Tree {
-    Nodes nodes;
-    ChildMap child_map;
-
-    Nodes getNear(const Vector2 target) const {
-        std::vector<NodePtr> near_nodes;
-        for (const NodePtr& node : nodes) {
-            if (goalReached(node, target)) {
-                near_nodes.push_back(node);
-            }
+    void addToGoalRegion(const NodeId node, const ObstacleGrid& obstacle_grid) {
+        is_goal_node.resize(pool.capacity(), false);
+        if (!inGoalRegion(node, obstacle_grid)) {
+            return;
         }
-        return near_nodes;
+        is_goal_node[node] = true;
+        goal_nodes.push_back(node);
+        considerGoalNode(node);
     }
 
-    void reset(const Vector2 start) {
-        nodes = {std::make_shared<Node>(Node{nullptr, start, 0.0f})};
-        child_map = buildChildMap(nodes);
+    void updateBestGoalNode() {
+        best_goal_node = NULL_NODE;
+        for (const NodeId node : goal_nodes) {
+            considerGoalNode(node);
+        }
+    }
+
+    // Rebuild the goal region from scratch. Only needed when the goal or the obstacles change.
+    void updateGoalRegion(const Vector2 new_goal, const ObstacleGrid& obstacle_grid) {
+        goal = new_goal;
+        for (const NodeId node : goal_nodes) {
+            is_goal_node[node] = false;
+        }
+        goal_nodes.clear();
+        is_goal_node.resize(pool.capacity(), false);
+        best_goal_node = NULL_NODE;
+
+        grid.forEachWithin(goal, GOAL_RADIUS, [&](const NodeId node, const float) { addToGoalRegion(node, obstacle_grid); });
+    }
+
+    NodeId addNode(const Vector2 pos, const float cost_to_come, const NodeId parent) {
+        const NodeId node = pool.add(pos, cost_to_come, parent);
+        birth_generation.resize(pool.capacity());
+        birth_generation[node] = generation;
+        return node;
+    }
+
+    void reset(const Problem& problem) {
+        pool.clear();
+        nodes = {addNode(problem.start, 0.0f, NULL_NODE)};
+        grid.build(pool, nodes);
+        edge_grid.clear();
+        updateGoalRegion(problem.goal, problem.obstacle_grid);
+    }
+
+    // Keep only the given nodes, which must hold every ancestor of their own, renumbered in the order given.
+    // Dropped nodes are never visited, so the cost grows with the retained set only. Invalidates all node handles.
+    void retain(const NodeIds& retained_nodes) {
+        retained.clear(pool.capacity());
+        for (const NodeId node : retained_nodes) {
+            retained.insert(node);
+        }
+        std::erase_if(goal_nodes, [&](const NodeId node) { return !retained.contains(node); });
+
+        std::vector<std::uint32_t> retained_birth_generation(retained_nodes.size());
+        for (std::size_t i = 0; i < retained_nodes.size(); ++i) {
+            retained_birth_generation[i] = birth_generation[retained_nodes[i]];
+        }
+        birth_generation = std::move(retained_birth_generation);
+
+        pool.compact(retained_nodes, new_ids);
+        is_goal_node.assign(pool.capacity(), false);
+        for (NodeId& node : goal_nodes) {
+            node = new_ids[node];
+            is_goal_node[node] = true;
+        }
+
+        nodes.resize(retained_nodes.size());
+        std::iota(nodes.begin(), nodes.end(), NodeId{0});
+        pool.relink(nodes);
+        grid.build(pool, nodes);
+        edge_grid.build(pool, nodes);
+        updateBestGoalNode();
     }
 
     void resetRoot(const Problem& problem, const Path& path) {
         // Special case: tree has zero or one node(s), just reset the whole tree.
         if (nodes.size() <= 1) {
-            reset(problem.start);
+            reset(problem);
             return;
         }
 
         // Collect the target nodes.
         // Target is goal region if any node reaches goal,
         // otherwise use path end.
-        Nodes target_nodes = getNear(problem.goal);
+        NodeIds target_nodes = goal_nodes;
         if ((target_nodes.size() == 0) && (path.size() > 0)) {
             target_nodes = {path.back()};
         }
 
         // For every ancestor on any target-reaching path, record the cheapest
         // downstream cost to a target along the existing tree.
-        std::unordered_map<NodePtr, float> cheapest_down;
-        for (const NodePtr& target_node : target_nodes) {
-            NodePtr cur = target_node;
-            while (cur) {
-                const float delta = target_node->cost_to_come - cur->cost_to_come;
+        std::unordered_map<NodeId, float> cheapest_down;
+        for (const NodeId target_node : target_nodes) {
+            NodeId cur = target_node;
+            while (cur != NULL_NODE) {
+                const float delta = pool.cost_to_come[target_node] - pool.cost_to_come[cur];
                 auto it = cheapest_down.find(cur);
                 if (it == cheapest_down.end() || delta < it->second) {
                     cheapest_down[cur] = delta;
                 }
-                cur = cur->parent;
+                cur = pool.parent[cur];
             }
         }
 
-        Nodes retained_nodes;
+        NodeIds retained_nodes;
 
         // Always create a fresh root at start.
-        NodePtr new_root = std::make_shared<Node>(Node{nullptr, problem.start, 0.0f});
+        const NodeId new_root = addNode(problem.start, 0.0f, NULL_NODE);
         retained_nodes.push_back(new_root);
 
         // Choose the child of the new root.
-        NodePtr best_child = nullptr;
+        NodeId best_child = NULL_NODE;
         float best_total = std::numeric_limits<float>::infinity();
 
         if (!cheapest_down.empty()) {
             for (const auto& kv : cheapest_down) {
-                const NodePtr& cand = kv.first;
-                const float dist = Vector2Distance(problem.start, cand->pos);
+                const NodeId cand = kv.first;
+                const float dist = Vector2Distance(problem.start, pool.pos[cand]);
                 if (dist > DEVIATION_DISTANCE_MAX) {
                     continue;
                 }
-                if (edgeCollides(problem.start, cand->pos, problem.obstacles)) {
+                if (edgeCollides(problem.start, pool.pos[cand], problem.obstacle_grid)) {
                     continue;
                 }
 
                 const float down_cost = kv.second;
-                const float up_cost = computeCost(problem.start, cand->pos);
+                const float up_cost = computeCost(problem.start, pool.pos[cand]);
                 const float total = up_cost + down_cost;
                 if (total < best_total) {
                     best_total = total;
@@ -242,9 +420,9 @@ struct Tree {
         } else if (!nodes.empty()) {
             // No node in the current tree reaches the target;
             // fall back to attaching the nearest node.
-            NodePtr cand = getNearest(problem.start, nodes);
-            const float dist = Vector2Distance(problem.start, cand->pos);
-            if (!((dist > DEVIATION_DISTANCE_MAX) || edgeCollides(problem.start, cand->pos, problem.obstacles))) {
+            const NodeId cand = getNearest(problem.start, grid);
+            const float dist = Vector2Distance(problem.start, pool.pos[cand]);
+            if (!((dist > DEVIATION_DISTANCE_MAX) || edgeCollides(problem.start, pool.pos[cand], problem.obstacle_grid))) {
                 best_child = cand;
             }
         }
@@ -252,181 +430,448 @@ struct Tree {
         // Retain only the subtree rooted at best_child (if any),
         // re-parent it to the new root,
         // and update costs throughout that subtree.
-        if (best_child) {
+        if (best_child != NULL_NODE) {
             // Re-parent attachment point and set its new cost_to_come.
-            best_child->parent = new_root;
-            best_child->cost_to_come = new_root->estimateCostTo(best_child->pos);
-            retained_nodes.push_back(best_child);
-
-            // Collect descendants of best_child using the current child_map.
-            std::function<void(const NodePtr&)> dfs = [&](const NodePtr& n) {
-                auto it = child_map.find(n);
-                if (it != child_map.end()) {
-                    for (const NodePtr& child : it->second) {
-                        retained_nodes.push_back(child);
-                        dfs(child);
-                    }
-                }
-            };
-            dfs(best_child);
+            pool.reparent(best_child, new_root);
+            pool.cost_to_come[best_child] = pool.estimateCostTo(new_root, pool.pos[best_child]);
+
+            // Collect best_child and its descendants.
+            walker.preorder(pool, best_child, [&](const NodeId node) {
+                retained_nodes.push_back(node);
+                return true;
+            });
         }
 
-        nodes = std::move(retained_nodes);
-        child_map = buildChildMap(nodes);
-        updateSubtreeCosts(new_root);
+        // Retaining renumbers the new root, which comes first, to the front.
+        retain(retained_nodes);
+        addToGoalRegion(root(), problem.obstacle_grid);
+        updateSubtreeCosts(root());
+        updateBestGoalNode();
     }
 
-    void carry(const Path path, const int num_carry, const Obstacles& obstacles) {
-        Nodes retained_nodes;
-        NodeSet retained_set;
+    // Move the root to the start while keeping the whole tree: attach the nearest reachable node to a new root,
+    // reverse the parent pointers on its path back to the old root, and recompute costs in one traversal.
+    // Falls back to resetRoot when no node can be attached.
+    void reroot(const Problem& problem, const Path& path) {
+        if (nodes.size() <= 1) {
+            reset(problem);
+            return;
+        }
 
-        // Ensure root is retained at the front.
-        NodePtr root = nodes.front();
-        retained_nodes.push_back(root);
-        retained_set.insert(root);
-
-        // Retain path.
-        if (!path.empty()) {
-            for (const NodePtr& node_add : path) {
-                if (retained_nodes.size() > num_carry) {
-                    break;
-                }
+        // Attach point: the nearest node within steering distance with a collision-free edge from the start.
+        std::vector<std::pair<float, NodeId>> candidates;
+        grid.forEachWithin(problem.start, DEVIATION_DISTANCE_MAX, [&](const NodeId node, const float dist) { candidates.push_back({dist, node}); });
+        std::sort(candidates.begin(), candidates.end());
 
-                if (retained_set.find(node_add) == retained_set.end()) {
-                    retained_nodes.push_back(node_add);
-                    retained_set.insert(node_add);
-                }
+        NodeId attach_node = NULL_NODE;
+        for (const auto& [dist, node] : candidates) {
+            if (!edgeCollides(problem.start, pool.pos[node], problem.obstacle_grid)) {
+                attach_node = node;
+                break;
             }
         }
+        if (attach_node == NULL_NODE) {
+            resetRoot(problem, path);
+            return;
+        }
 
-        // Retain random nodes & all their ancestors.
-        Nodes shuffled = nodes;
-        std::shuffle(shuffled.begin(), shuffled.end(), rng);
-        for (const NodePtr& node : shuffled) {
-            if (retained_nodes.size() > num_carry) {
-                break;
-            }
+        // Reverse the path from the attach point up to the old root, which becomes an ordinary node.
+        const NodeId new_root = addNode(problem.start, 0.0f, NULL_NODE);
+        NodeId child = new_root;
+        NodeId node = attach_node;
+        while (node != NULL_NODE) {
+            const NodeId next = pool.parent[node];
+            pool.parent[node] = child;
+            child = node;
+            node = next;
+        }
 
-            std::shared_ptr<Node> node_add = node;
-            while (node_add) {
-                if (retained_set.find(node_add) == retained_set.end()) {
-                    retained_nodes.push_back(node_add);
-                    retained_set.insert(node_add);
-                }
-                node_add = node_add->parent;
+        NodeIds retained_nodes;
+        retained_nodes.reserve(nodes.size() + 1);
+        retained_nodes.push_back(new_root);
+        retained_nodes.insert(retained_nodes.end(), nodes.begin(), nodes.end());
+
+        // Relinks child lists from the new parent pointers, and renumbers the new root to the front.
+        retain(retained_nodes);
+        const NodeId root_node = root();
+        addToGoalRegion(root_node, problem.obstacle_grid);
+        updateSubtreeCosts(root_node);
+
+        // Nodes around the new root are usually cheaper to reach from it directly than through the old root.
+        // Reparent them all, then relink and update costs once, rather than once per reparented subtree as rewire would.
+        grid.forEachWithin(problem.start, REWIRE_RADIUS, [&](const NodeId neighbor, const float cost) {
+            if ((neighbor == root_node) || (pool.parent[neighbor] == root_node) || (cost >= pool.cost_to_come[neighbor])) {
+                return;
             }
-        }
+            if (edgeCollides(problem.start, pool.pos[neighbor], problem.obstacle_grid)) {
+                return;
+            }
+            pool.parent[neighbor] = root_node;
+            edge_grid.insert(pool, neighbor);
+        });
+        pool.relink(nodes);
+        updateSubtreeCosts(root_node);
+        updateBestGoalNode();
+    }
 
-        nodes = std::move(retained_nodes);
-        child_map = buildChildMap(nodes);
+    // Chance that carry keeps a drawn node under the policy, relative to the straight-line cost from the root to the goal
+    // and the mean occupancy of the node grid.
+    float carryWeight(const NodeId node, const CarryPolicy policy, const float cost_ref, const float occupancy_mean) const {
+        switch (policy) {
+            case CarryPolicy::COST:
+                return std::pow(cost_ref / std::max(pool.estimateCostTo(node, goal), cost_ref), CARRY_COST_EXPONENT);
+            case CarryPolicy::COVERAGE:
+                return std::min(1.0f, occupancy_mean / grid.occupancy(pool.pos[node]));
+            case CarryPolicy::AGE:
+                return std::min(1.0f, static_cast<float>(generation - birth_generation[node] + 1) / CARRY_AGE_SATURATION);
+            default:
+                return 1.0f;
+        }
     }
 
-    void cullByObstacles(const Obstacles& obstacles) {
-        Nodes retained_nodes;
+    // Keep the root, the path and random nodes with their ancestors, about num_carry nodes in all.
+    // The retained set always holds every ancestor of its nodes, so adding a node stops at its first retained ancestor.
+    void carry(const Path& path, const int num_carry, const CarryPolicy policy, Rng rng) {
+        const std::size_t num_carry_max = static_cast<std::size_t>(std::max(num_carry, 0));
+        NodeIds retained_nodes;
+        retained_nodes.reserve(num_carry_max + 1);
+        retained.clear(pool.capacity());
+
+        // Nodes allocated straight from the pool, rather than through addNode, count as born this generation.
+        birth_generation.resize(pool.capacity(), generation);
 
         // Ensure root is retained at the front.
-        NodePtr root = nodes.front();
-        retained_nodes.push_back(root);
+        const NodeId root_node = root();
+        retained_nodes.push_back(root_node);
+        retained.insert(root_node);
 
-        // Traverse from root and keep only collision-free nodes and subtrees.
-        std::function<void(const NodePtr&)> dfs = [&](const NodePtr& node) {
-            if (edgeCollides(node, obstacles)) {
-                // Prune entire subtree.
-                return;
+        // Retain path. It runs down from the root, so every prefix holds its own ancestors.
+        for (const NodeId node_add : path) {
+            if (retained_nodes.size() > num_carry_max) {
+                break;
             }
+            if (retained.insert(node_add)) {
+                retained_nodes.push_back(node_add);
+            }
+        }
 
-            // Keep this node.
-            if (node != root) {
-                retained_nodes.push_back(node);
+        // Branch and bound: cost-to-come plus cost-to-go never decreases going down a branch,
+        // so a node that cannot beat the best solution has no descendant that can.
+        const float cost_bound = bestCost();
+
+        // The cost policy weighs nodes against the straight-line cost from the root, the least any node can estimate,
+        // so nodes are still graded once branch and bound has dropped those that cannot beat the best solution.
+        const float cost_ref = computeCost(pool.pos[root_node], goal);
+        const float occupancy_mean = (policy == CarryPolicy::COVERAGE) ? grid.meanOccupancy() : 0.0f;
+
+        // Retain random nodes & all their ancestors. Nodes are drawn without replacement by a Fisher-Yates shuffle
+        // of the node list that stops as soon as enough are retained; the root stays in front.
+        // A drawn node is kept with the chance its policy weight gives, and is otherwise passed over for good.
+        const std::uint32_t num_nodes = static_cast<std::uint32_t>(nodes.size());
+        for (std::uint32_t i = 1; (i < num_nodes) && (retained_nodes.size() <= num_carry_max); ++i) {
+            std::swap(nodes[i], nodes[i + rng.uniformIndex(num_nodes - i)]);
+            const NodeId node = nodes[i];
+
+            if (pool.estimateCostTo(node, goal) > cost_bound) {
+                continue;
             }
 
-            // Recurse on children.
-            auto it = child_map.find(node);
-            if (it != child_map.end()) {
-                for (const NodePtr& child : it->second) {
-                    dfs(child);
-                }
+            const float weight = carryWeight(node, policy, cost_ref, occupancy_mean);
+            if ((weight < 1.0f) && (rng.uniform() >= weight)) {
+                continue;
+            }
+
+            for (NodeId node_add = node; (node_add != NULL_NODE) && retained.insert(node_add); node_add = pool.parent[node_add]) {
+                retained_nodes.push_back(node_add);
+            }
+        }
+
+        generation++;
+        retain(retained_nodes);
+    }
+
+    // Drop every subtree whose edge is blocked by one of the added obstacles.
+    // Edges were collision-free before the edit, so only edges near the added obstacles need checking.
+    // Culled nodes are taken out of the grids, goal region and pool one by one, so the rest of the tree is untouched
+    // apart from one pass over the node list, and the handles of surviving nodes stay valid.
+    void cullByObstacles(const Obstacles& added_obstacles, const ObstacleGrid& obstacle_grid) {
+        NodeIds blocked_nodes;
+        const NodeId root_node = root();
+        if (collides(pool.pos[root_node], obstacle_grid)) {
+            // A blocked root blocks everything.
+            for (NodeId child = pool.first_child[root_node]; child != NULL_NODE; child = pool.next_sibling[child]) {
+                blocked_nodes.push_back(child);
             }
-        };
+        } else {
+            for (const Obstacle obstacle : added_obstacles) {
+                const Vector2 delta = {OBSTACLE_RADIUS, OBSTACLE_RADIUS};
+                edge_grid.forEachInBox(obstacle - delta, obstacle + delta, [&](const NodeId node) {
+                    // Skip entries whose slot an earlier cull freed.
+                    if (!pool.hasParent(node)) {
+                        return;
+                    }
+                    if (segmentCollides(pool.pos[pool.parent[node]], pool.pos[node], obstacle)) {
+                        blocked_nodes.push_back(node);
+                    }
+                });
+            }
+        }
+        if (blocked_nodes.empty()) {
+            return;
+        }
 
-        dfs(root);
+        // Collect the subtrees of all blocked nodes.
+        // A subtree already culled through another blocked node is not walked again.
+        culled.clear(pool.capacity());
+        culled_nodes.clear();
+        for (const NodeId blocked_node : blocked_nodes) {
+            walker.preorder(pool, blocked_node, [&](const NodeId node) {
+                if (!culled.insert(node)) {
+                    return false;
+                }
+                culled_nodes.push_back(node);
+                return true;
+            });
+        }
+
+        // Grid entries are found from the culled nodes' positions and edges, so drop them before detaching anything.
+        grid.remove(pool, culled_nodes, culled);
+        edge_grid.remove(pool, culled_nodes, culled);
+
+        // Detach the culled subtrees, sweeping each surviving parent's child list once however many children it loses.
+        NodeIds cut_parents;
+        for (const NodeId node : culled_nodes) {
+            if (!culled.contains(pool.parent[node])) {
+                cut_parents.push_back(pool.parent[node]);
+            }
+        }
+        std::sort(cut_parents.begin(), cut_parents.end());
+        cut_parents.erase(std::unique(cut_parents.begin(), cut_parents.end()), cut_parents.end());
+        for (const NodeId cut_parent : cut_parents) {
+            pool.unlinkChildrenIf(cut_parent, [&](const NodeId child) { return culled.contains(child); });
+        }
+        for (const NodeId node : culled_nodes) {
+            pool.remove(node);
+        }
 
-        nodes = std::move(retained_nodes);
-        child_map = buildChildMap(nodes);
+        std::erase_if(nodes, [&](const NodeId node) { return culled.contains(node); });
+        std::erase_if(goal_nodes, [&](const NodeId node) {
+            if (!culled.contains(node)) {
+                return false;
+            }
+            is_goal_node[node] = false;
+            return true;
+        });
+        updateBestGoalNode();
     }
 
-    void growOnce(Vector2 pos, const Obstacles& obstacles, const bool rewire_enabled) {
-        NodePtr parent = getParent(pos, nodes, obstacles, REWIRE_RADIUS);
+    // Choose a parent for the sample, steer toward it and gather the neighborhood rewiring will need.
+    // When steering leaves the sample in place, the neighborhood searched for the parent is kept, with its distances
+    // and whatever collision checks parent selection made, and the parent edge is already known to be free.
+    // Does not modify the tree.
+    void propose(const Vector2 sample, const ObstacleGrid& obstacle_grid, const ConnectionRange range, GrowthCandidate& candidate) const {
+        queryNeighborhood(sample, grid, range, candidate.neighborhood);
+        const NodeId cheapest = getCheapest(sample, pool, obstacle_grid, candidate.neighborhood);
+        const NodeId parent = (cheapest != NULL_NODE) ? cheapest : getNearest(sample, grid);
+
+        Vector2 pos = clampToEnvironment(sample);
+        pos = attractByDistance(pos, pool, parent);
+        pos = attractByAngle(pos, pool, parent);
 
-        pos = clampToEnvironment(pos);
-        pos = attractByDistance(pos, parent);
-        pos = attractByAngle(pos, parent);
+        candidate.parent = parent;
+        candidate.pos = pos;
+        candidate.valid = false;
 
         if (!insideEnvironment(pos)) {
             return;
         }
 
-        if (edgeCollides(parent->pos, pos, obstacles)) {
+        const bool steered = (pos.x != sample.x) || (pos.y != sample.y);
+        if (steered || (cheapest == NULL_NODE)) {
+            if (edgeCollides(pool.pos[parent], pos, obstacle_grid)) {
+                return;
+            }
+            queryNeighborhood(pos, grid, range, candidate.neighborhood);
+        }
+
+        candidate.valid = true;
+    }
+
+    void commit(const GrowthCandidate& candidate, const ObstacleGrid& obstacle_grid, const bool rewire_enabled) {
+        if (!candidate.valid) {
             return;
         }
 
-        const float cost_to_come = parent->estimateCostTo(pos);
-        NodePtr node = std::make_shared<Node>(Node{parent, pos, cost_to_come});
+        const float cost_to_come = resolvedCost(candidate.parent) + computeCost(pool.pos[candidate.parent], candidate.pos);
+        const NodeId node = addNode(candidate.pos, cost_to_come, candidate.parent);
         nodes.push_back(node);
-        child_map[node->parent].insert(node);
+        grid.insert(node, candidate.pos);
+        edge_grid.insert(pool, node);
+        addToGoalRegion(node, obstacle_grid);
+        num_neighbors_grown += candidate.neighborhood.size();
 
         if (rewire_enabled) {
-            rewire(node, obstacles);
+            rewire(node, candidate.neighborhood, obstacle_grid);
         }
     }
 
-    void rewire(const NodePtr& new_node, const Obstacles& obstacles) {
-        for (NodePtr& neighbor : nodes) {
-            if (neighbor == new_node || neighbor == new_node->parent) {
-                continue;
-            }
+    // Commits one sample with costs resolved straight away, so the next proposal sees exact costs.
+    void growOnce(const Vector2 pos, const ObstacleGrid& obstacle_grid, const bool rewire_enabled, const ConnectionMode connection_mode) {
+        propose(pos, obstacle_grid, computeConnectionRange(connection_mode, nodes.size()), growth_candidate);
+        commit(growth_candidate, obstacle_grid, rewire_enabled);
+        resolveCosts();
+    }
 
-            const float cost = computeCost(new_node->pos, neighbor->pos);
-            if (cost > REWIRE_RADIUS) {
+    // Reparent neighbors that are cheaper to reach through the new node. Only those edges are checked, and edges
+    // already checked during parent selection are not checked again.
+    // A stored cost is an upper bound, so it can rule a neighbor out; a neighbor that passes is compared again against
+    // its exact cost, since one below an earlier rewire may already be cheaper than the new route.
+    void rewire(const NodeId new_node, const Neighborhood& neighborhood, const ObstacleGrid& obstacle_grid) {
+        const Vector2 new_pos = pool.pos[new_node];
+        for (const auto& [neighbor, cost, edge] : neighborhood) {
+            if (neighbor == new_node || neighbor == pool.parent[new_node]) {
                 continue;
             }
 
-            const float new_cost_to_come_of_neighbor = new_node->cost_to_come + cost;
-            const bool cost_improved = new_cost_to_come_of_neighbor < neighbor->cost_to_come;
+            const float new_cost_to_come_of_neighbor = pool.cost_to_come[new_node] + cost;
+            const bool cost_improved = (new_cost_to_come_of_neighbor < pool.cost_to_come[neighbor]) && (new_cost_to_come_of_neighbor < resolvedCost(neighbor));
             if (cost_improved) {
-                if (edgeCollides(new_node->pos, neighbor->pos, obstacles)) {
+                const bool collides = (edge == EdgeStatus::UNCHECKED) ? edgeCollides(new_pos, pool.pos[neighbor], obstacle_grid) : (edge == EdgeStatus::BLOCKED);
+                if (collides) {
                     continue;
                 }
 
                 // TODO check that new edge honors attractByAngle constraint
 
-                child_map[neighbor->parent].erase(neighbor);
-                neighbor->parent = new_node;
-                neighbor->cost_to_come = new_cost_to_come_of_neighbor;
-                child_map[new_node].insert(neighbor);
-                updateSubtreeCosts(neighbor);
+                pool.reparent(neighbor, new_node);
+                edge_grid.insert(pool, neighbor);
+                pool.cost_to_come[neighbor] = new_cost_to_come_of_neighbor;
+                considerGoalNode(neighbor);
+                markStale(neighbor);
             }
         }
     }
 
-    void updateSubtreeCosts(const NodePtr& node) {
-        std::function<void(const NodePtr&)> dfs = [&](const NodePtr& current) {
-            auto it = child_map.find(current);
-            if (it != child_map.end()) {
-                for (const NodePtr& child : it->second) {
-                    child->cost_to_come = current->estimateCostTo(child->pos);
-                    dfs(child);
+    void markStale(const NodeId node) {
+        if (stale_roots.empty()) {
+            is_stale_root.clear(pool.capacity());
+        } else {
+            is_stale_root.grow(pool.capacity());
+        }
+        if (is_stale_root.insert(node)) {
+            stale_roots.push_back(node);
+        }
+    }
+
+    // Exact cost-to-come of a node while stale subtrees are pending. Nothing above the topmost stale root on the node's
+    // path has changed, so its parent's stored cost is exact and the costs below it are recomputed from there.
+    float resolvedCost(const NodeId node) {
+        if (stale_roots.empty()) {
+            return pool.cost_to_come[node];
+        }
+
+        // Nodes added since the first stale root have no mark yet.
+        is_stale_root.grow(pool.capacity());
+
+        cost_chain.clear();
+        std::size_t num_stale = 0;
+        for (NodeId current = node; current != NULL_NODE; current = pool.parent[current]) {
+            cost_chain.push_back(current);
+            if (is_stale_root.contains(current)) {
+                num_stale = cost_chain.size();
+            }
+        }
+        if (num_stale == 0) {
+            return pool.cost_to_come[node];
+        }
+
+        // The root is never rewired, so the topmost stale root has a parent.
+        float cost_to_come = pool.cost_to_come[cost_chain[num_stale]];
+        for (std::size_t i = num_stale; i > 0; --i) {
+            cost_to_come += computeCost(pool.pos[cost_chain[i]], pool.pos[cost_chain[i - 1]]);
+        }
+        return cost_to_come;
+    }
+
+    // Bring every stale subtree back to exact costs, each stale root recomputed from its parent.
+    // A walk stops below a node whose cost comes out unchanged: its children were last computed from that same cost,
+    // or sit below a stale root of their own.
+    void resolveCosts() {
+        for (const NodeId stale_root : stale_roots) {
+            walker.preorder(pool, stale_root, [&](const NodeId node) {
+                const float cost_to_come = pool.estimateCostTo(pool.parent[node], pool.pos[node]);
+                if ((node != stale_root) && (cost_to_come == pool.cost_to_come[node])) {
+                    return false;
                 }
+                pool.cost_to_come[node] = cost_to_come;
+                considerGoalNode(node);
+                return true;
+            });
+        }
+        stale_roots.clear();
+    }
+
+    // Recompute the cost-to-come of every descendant of node from its parent's, parents first.
+    void updateSubtreeCosts(const NodeId node) {
+        walker.preorder(pool, node, [&](const NodeId current) {
+            if (current != node) {
+                pool.cost_to_come[current] = pool.estimateCostTo(pool.parent[current], pool.pos[current]);
+                considerGoalNode(current);
+            }
+            return true;
+        });
+    }
+
+    // Propose a batch of samples in parallel against the tree as it stands, then commit them in sample order
+    // and resolve the costs their rewires left stale in one pass.
+    // Samples depend only on their index and commits are ordered, so the result does not depend on the thread count.
+    void growBatched(const Problem& problem, const int num_samples, const bool rewire_enabled, const ConnectionMode connection_mode, const bool informed_enabled, const Rng& rng) {
+        ThreadPool& thread_pool = getThreadPool();
+        SampleBatch samples;
+        std::vector<GrowthCandidate> candidates;
+
+        int num_grown = 0;
+        while (num_grown < num_samples) {
+            // Candidates in one batch cannot attach to each other, so keep batches small relative to the tree.
+            const int batch_size_max = std::min(GROW_BATCH_SIZE_MAX, num_samples - num_grown);
+            const int batch_size = std::clamp(static_cast<int>(nodes.size()) / GROW_BATCH_TREE_FRACTION, 1, batch_size_max);
+
+            fillSamples(problem.goal, informedSet(informed_enabled), rng, num_grown, batch_size, samples);
+
+            candidates.resize(batch_size);
+            const ConnectionRange range = computeConnectionRange(connection_mode, nodes.size());
+            thread_pool.parallelFor(batch_size, [&](const int i) { propose(samples.at(i), problem.obstacle_grid, range, candidates[i]); });
+
+            for (const GrowthCandidate& candidate : candidates) {
+                commit(candidate, problem.obstacle_grid, rewire_enabled);
             }
-        };
+            resolveCosts();
 
-        dfs(node);
+            num_grown += batch_size;
+        }
     }
 
-    void grow(const Problem& problem, const int num_samples, const bool rewire_enabled) {
-        for (int i = 0; i < num_samples; ++i) {
-            const Vector2 pos = sample(problem.goal);
-            growOnce(pos, problem.obstacles, rewire_enabled);
+    void grow(const Problem& problem, const int num_samples, const bool rewire_enabled, const ConnectionMode connection_mode, const bool parallel_enabled, const bool informed_enabled, const Rng& rng) {
+        const std::size_t num_nodes_before = nodes.size();
+        num_neighbors_grown = 0;
+
+        if (parallel_enabled) {
+            growBatched(problem, num_samples, rewire_enabled, connection_mode, informed_enabled, rng);
+        } else {
+            // Samples are still generated in batches; the informed set is refreshed between them.
+            SampleBatch samples;
+            for (int num_grown = 0; num_grown < num_samples; num_grown += GROW_BATCH_SIZE_MAX) {
+                const int batch_size = std::min(GROW_BATCH_SIZE_MAX, num_samples - num_grown);
+                fillSamples(problem.goal, informedSet(informed_enabled), rng, num_grown, batch_size, samples);
+                for (int i = 0; i < batch_size; ++i) {
+                    growOnce(samples.at(i), problem.obstacle_grid, rewire_enabled, connection_mode);
+                }
+            }
+        }
+
+        const std::size_t num_added = nodes.size() - num_nodes_before;
+        if (num_added > 0) {
+            mean_neighborhood_size = static_cast<float>(num_neighbors_grown) / num_added;
         }
     }
 };
@@ -34,7 +34,14 @@ static constexpr int CTRL_BAR_BUTTON_HEIGHT = 2 * CTRL_BAR_ROW_HEIGHT - BUTTON_S
 static constexpr int CTRL_BAR_BUTTON_WIDTH = CTRL_BAR_COL_WIDTH - 1.5 * BUTTON_SPACING_X;
 static constexpr int CTRL_BAR_BUTTON_X_MIN = CTRL_BAR_X_MIN + BUTTON_SPACING_X;
 static constexpr int CTRL_BAR_BUTTON_X_MAX = CTRL_BAR_BUTTON_X_MIN + CTRL_BAR_BUTTON_WIDTH;
+static constexpr int CTRL_BAR_THIRD_BUTTON_WIDTH = (CTRL_BAR_BUTTON_WIDTH - BUTTON_SPACING_X) / 3;
+static constexpr int CTRL_BAR_THIRD_BUTTON_STRIDE = CTRL_BAR_THIRD_BUTTON_WIDTH + BUTTON_SPACING_X / 2;
 static constexpr int CTRL_BAR_WIDE_BUTTON_WIDTH = CTRL_BAR_WIDTH - 2 * BUTTON_SPACING_X;
+static constexpr int CTRL_BAR_THIRD_WIDE_BUTTON_WIDTH = (CTRL_BAR_WIDE_BUTTON_WIDTH - 2 * BUTTON_SPACING_Y) / 3;
+static constexpr int CTRL_BAR_QUARTER_WIDE_BUTTON_WIDTH = (CTRL_BAR_WIDE_BUTTON_WIDTH - 3 * BUTTON_SPACING_Y) / 4;
+
+// Spinners take one row so the label under each one and the toggle group below that fit in the remaining two.
+static constexpr int CTRL_BAR_SPINNER_HEIGHT = CTRL_BAR_ROW_HEIGHT;
 
 static constexpr int CTRL_BAR_VIS_BUTTON_WIDTH = (CTRL_BAR_WIDTH - 4 * BUTTON_SPACING_X) / 3;
 static constexpr int CTRL_BAR_VIS_BUTTON_HEIGHT = 2 * CTRL_BAR_ROW_HEIGHT - 2 * BUTTON_SPACING_Y;
@@ -59,9 +66,17 @@ void ctrlProblemEdit(CtrlState& state) {
     GuiToggleGroup(problem_edit_mode_bounds, icons, &problem_edit_mode_int);
     state.problem_edit_mode = static_cast<ProblemEditMode>(problem_edit_mode_int);
 
+    GuiSetIconScale(TINY_BUTTON_ICON_SCALE);
+
     // Remove All Obstacles
-    GuiSetIconScale(SMALL_BUTTON_ICON_SCALE);
-    state.reset_obstacles = GuiButton((Rectangle){CTRL_BAR_COL_0_X + BUTTON_SPACING_X, CTRL_BAR_ROW_11_Y, CTRL_BAR_BUTTON_WIDTH, CTRL_BAR_ROW_HEIGHT}, GuiIconText(ICON_BIN, NULL));
+    state.reset_obstacles = GuiButton((Rectangle){CTRL_BAR_COL_0_X + BUTTON_SPACING_X + 0 * CTRL_BAR_THIRD_BUTTON_STRIDE, CTRL_BAR_ROW_11_Y, CTRL_BAR_THIRD_BUTTON_WIDTH, CTRL_BAR_ROW_HEIGHT}, GuiIconText(ICON_BIN, NULL));
+
+    // Re-root Tree on Start Change
+    GuiToggle((Rectangle){CTRL_BAR_COL_0_X + BUTTON_SPACING_X + 1 * CTRL_BAR_THIRD_BUTTON_STRIDE, CTRL_BAR_ROW_11_Y, CTRL_BAR_THIRD_BUTTON_WIDTH, CTRL_BAR_ROW_HEIGHT}, GuiIconText(ICON_TARGET_MOVE, NULL), &state.reroot_enabled);
+
+    // Plan with RRTX Graph
+    GuiToggle((Rectangle){CTRL_BAR_COL_0_X + BUTTON_SPACING_X + 2 * CTRL_BAR_THIRD_BUTTON_STRIDE, CTRL_BAR_ROW_11_Y, CTRL_BAR_THIRD_BUTTON_WIDTH, CTRL_BAR_ROW_HEIGHT}, GuiIconText(ICON_LINK_MULTI, NULL), &state.rrtx_enabled);
+
     GuiSetIconScale(BUTTON_ICON_SCALE);
 
     // Snap to Grid
@@ -96,9 +111,17 @@ void ctrlTreeGrowth(CtrlState& state, const bool goal_reached) {
     // Reset Tree
     state.tree_edits.should_reset = GuiButton((Rectangle){CTRL_BAR_COL_1_X + BUTTON_SPACING_X / 2, CTRL_BAR_ROW_9_Y, CTRL_BAR_BUTTON_WIDTH, CTRL_BAR_BUTTON_HEIGHT}, GuiIconText(ICON_RESTART, NULL));
 
+    GuiSetIconScale(TINY_BUTTON_ICON_SCALE);
+
     // Rewiring Enabled
-    GuiSetIconScale(SMALL_BUTTON_ICON_SCALE);
-    GuiToggle((Rectangle){CTRL_BAR_COL_1_X + BUTTON_SPACING_X / 2, CTRL_BAR_ROW_11_Y, CTRL_BAR_BUTTON_WIDTH, CTRL_BAR_ROW_HEIGHT}, GuiIconText(ICON_SHUFFLE_FILL, NULL), &state.rewire_enabled);
+    GuiToggle((Rectangle){CTRL_BAR_COL_1_X + BUTTON_SPACING_X / 2 + 0 * CTRL_BAR_THIRD_BUTTON_STRIDE, CTRL_BAR_ROW_11_Y, CTRL_BAR_THIRD_BUTTON_WIDTH, CTRL_BAR_ROW_HEIGHT}, GuiIconText(ICON_SHUFFLE_FILL, NULL), &state.rewire_enabled);
+
+    // Informed Sampling Enabled
+    GuiToggle((Rectangle){CTRL_BAR_COL_1_X + BUTTON_SPACING_X / 2 + 1 * CTRL_BAR_THIRD_BUTTON_STRIDE, CTRL_BAR_ROW_11_Y, CTRL_BAR_THIRD_BUTTON_WIDTH, CTRL_BAR_ROW_HEIGHT}, GuiIconText(ICON_LENS, NULL), &state.informed_sampling_enabled);
+
+    // Parallel Growth Enabled
+    GuiToggle((Rectangle){CTRL_BAR_COL_1_X + BUTTON_SPACING_X / 2 + 2 * CTRL_BAR_THIRD_BUTTON_STRIDE, CTRL_BAR_ROW_11_Y, CTRL_BAR_THIRD_BUTTON_WIDTH, CTRL_BAR_ROW_HEIGHT}, GuiIconText(ICON_CPU, NULL), &state.parallel_grow_enabled);
+
     GuiSetIconScale(BUTTON_ICON_SCALE);
 }
 
@@ -106,11 +129,52 @@ void ctrlTreeSize(CtrlState& state) {
     GuiSetStyle(VALUEBOX, SPINNER_BUTTON_WIDTH, CTRL_BAR_BUTTON_WIDTH);
     GuiSetStyle(DEFAULT, TEXT_SIZE, BIG_TEXT_HEIGHT);
 
-    GuiLabelSpinner((Rectangle){CTRL_BAR_BUTTON_X_MIN, CTRL_BAR_ROW_12_Y + BUTTON_SPACING_Y, CTRL_BAR_WIDE_BUTTON_WIDTH, CTRL_BAR_BUTTON_HEIGHT}, "Carry", &state.num_carry_ix, NUM_CARRY_OPTIONS);
+    GuiLabelSpinner((Rectangle){CTRL_BAR_BUTTON_X_MIN, CTRL_BAR_ROW_12_Y + BUTTON_SPACING_Y, CTRL_BAR_WIDE_BUTTON_WIDTH, CTRL_BAR_SPINNER_HEIGHT}, "Carry", &state.num_carry_ix, NUM_CARRY_OPTIONS);
+
+    GuiSetStyle(DEFAULT, TEXT_SIZE, TEXT_HEIGHT);
+    GuiSetIconScale(TINY_BUTTON_ICON_SCALE);
 
-    GuiLabelSpinner((Rectangle){CTRL_BAR_BUTTON_X_MIN, CTRL_BAR_ROW_15_Y + BUTTON_SPACING_Y, CTRL_BAR_WIDE_BUTTON_WIDTH, CTRL_BAR_BUTTON_HEIGHT}, "Samples", &state.num_samples_ix, NUM_SAMPLES_OPTIONS);
+    int carry_policy_int = static_cast<int>(state.carry_policy);
+    const Rectangle carry_policy_bounds = {CTRL_BAR_BUTTON_X_MIN, CTRL_BAR_ROW_14_Y + BUTTON_SPACING_Y / 2, CTRL_BAR_QUARTER_WIDE_BUTTON_WIDTH, CTRL_BAR_ROW_HEIGHT - BUTTON_SPACING_Y};
+
+    char icon1[32];
+    char icon2[32];
+    char icon3[32];
+    char icon4[32];
+
+    strcpy(icon1, GuiIconText(ICON_SHUFFLE, NULL));
+    strcpy(icon2, GuiIconText(ICON_COIN, NULL));
+    strcpy(icon3, GuiIconText(ICON_GRID_FILL, NULL));
+    strcpy(icon4, GuiIconText(ICON_CLOCK, NULL));
+
+    const char* icons = TextFormat("%s;%s;%s;%s", icon1, icon2, icon3, icon4);
+
+    // Carry Uniform, Carry by Cost, Carry by Coverage, Carry by Age
+    GuiToggleGroup(carry_policy_bounds, icons, &carry_policy_int);
+    state.carry_policy = static_cast<CarryPolicy>(carry_policy_int);
+
+    GuiSetIconScale(BUTTON_ICON_SCALE);
+    GuiSetStyle(DEFAULT, TEXT_SIZE, BIG_TEXT_HEIGHT);
+
+    GuiLabelSpinner((Rectangle){CTRL_BAR_BUTTON_X_MIN, CTRL_BAR_ROW_15_Y + BUTTON_SPACING_Y, CTRL_BAR_WIDE_BUTTON_WIDTH, CTRL_BAR_SPINNER_HEIGHT}, "Samples", &state.num_samples_ix, NUM_SAMPLES_OPTIONS);
 
     GuiSetStyle(DEFAULT, TEXT_SIZE, TEXT_HEIGHT);
+    GuiSetIconScale(TINY_BUTTON_ICON_SCALE);
+
+    int connection_mode_int = static_cast<int>(state.connection_mode);
+    const Rectangle connection_mode_bounds = {CTRL_BAR_BUTTON_X_MIN, CTRL_BAR_ROW_17_Y + BUTTON_SPACING_Y / 2, CTRL_BAR_THIRD_WIDE_BUTTON_WIDTH, CTRL_BAR_ROW_HEIGHT - BUTTON_SPACING_Y};
+
+    strcpy(icon1, GuiIconText(ICON_TARGET_BIG, NULL));
+    strcpy(icon2, GuiIconText(ICON_TARGET_SMALL, NULL));
+    strcpy(icon3, GuiIconText(ICON_BOX_DOTS_SMALL, NULL));
+
+    const char* connection_icons = TextFormat("%s;%s;%s", icon1, icon2, icon3);
+
+    // Connect Fixed Radius, Connect Shrinking Radius, Connect k-Nearest
+    GuiToggleGroup(connection_mode_bounds, connection_icons, &connection_mode_int);
+    state.connection_mode = static_cast<ConnectionMode>(connection_mode_int);
+
+    GuiSetIconScale(BUTTON_ICON_SCALE);
 }
 
 void ctrlVisibility(CtrlState& state) {
@@ -39,10 +39,10 @@ void DrawEnvironment(const Problem& problem, const Planner& planner, const Vecto
         DrawObstacles(problem.obstacles);
     }
     if (ctrl_state.visibility.tree) {
-        DrawTree(planner.tree, planner.path, problem.goal, goal_reached);
+        DrawTree(planner.pool(), planner.nodes(), planner.root(), planner.path, planner.pathTarget(problem), goal_reached);
     }
     if (ctrl_state.visibility.path) {
-        DrawPath(planner.path, goal_reached);
+        DrawPath(planner.pool(), planner.path, goal_reached);
     }
     DrawObjectBrush(brush_pos, getObjectBrushParams(ctrl_state.problem_edit_mode));
     DrawStart(problem.start);
@@ -7,13 +7,13 @@
 #include "planner/path.h"
 #include "ui/colors.h"
 
-void DrawPath(const Path& path, const bool goal_reached) {
+void DrawPath(const NodePool& pool, const Path& path, const bool goal_reached) {
     const Color color = goal_reached ? COLOR_PATH_GOAL_REACHED : COLOR_PATH_GOAL_NOT_REACHED;
-    for (const NodePtr& node : path) {
-        if (!node->parent) {
+    for (const NodeId node : path) {
+        if (!pool.hasParent(node)) {
             continue;
         }
-        DrawLineEx(node->parent->pos, node->pos, LINE_WIDTH_PATH, color);
-        DrawCircleV(node->pos, 0.5f * LINE_WIDTH_PATH, color);
+        DrawLineEx(pool.pos[pool.parent[node]], pool.pos[node], LINE_WIDTH_PATH, color);
+        DrawCircleV(pool.pos[node], 0.5f * LINE_WIDTH_PATH, color);
     }
 }
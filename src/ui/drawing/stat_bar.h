@@ -6,7 +6,7 @@
 #include "core/obstacle.h"
 #include "core/timing_parts.h"
 #include "planner/cost.h"
-#include "planner/tree.h"
+#include "planner/planner.h"
 #include "ui/colors.h"
 #include "ui/gui_label.h"
 
@@ -39,8 +39,10 @@ void DrawStatBar(const Problem& problem, const Planner& planner, const Vector2 b
     GuiSetStyle(DEFAULT, TEXT_SIZE, BIG_TEXT_HEIGHT);
     GuiLabelValueColor((Rectangle){STAT_BAR_BUTTON_X_MIN, ROW_1_Y, STAT_BAR_BUTTON_WIDTH, STAT_BAR_ROW_HEIGHT}, "Goal", goal_reached ? "Reached" : "Missed", computeGoalColor(goal_reached));
 
-    const float path_cost_to_come = planner.path.back()->cost_to_come;
-    const float path_cost_to_go = computeCost(planner.path.back()->pos, problem.goal);
+    const NodePool& pool = planner.pool();
+    const Vector2 path_target = planner.pathTarget(problem);
+    const float path_cost_to_come = pool.cost_to_come[planner.path.back()];
+    const float path_cost_to_go = computeCost(pool.pos[planner.path.back()], path_target);
     const float path_cost = path_cost_to_come + path_cost_to_go;
     GuiSetStyle(DEFAULT, TEXT_SIZE, BIG_TEXT_HEIGHT);
     GuiLabelValueColor((Rectangle){STAT_BAR_BUTTON_X_MIN, ROW_3_Y, STAT_BAR_BUTTON_WIDTH, STAT_BAR_ROW_HEIGHT}, "Cost", TextFormat("%d", std::lround(path_cost)), goal_reached ? COLOR_STAT : COLOR_PATH_GOAL_NOT_REACHED);
@@ -49,9 +51,14 @@ void DrawStatBar(const Problem& problem, const Planner& planner, const Vector2 b
     GuiLabelValueColor((Rectangle){STAT_BAR_BUTTON_X_MIN, ROW_4_Y, STAT_BAR_BUTTON_WIDTH, STAT_BAR_HALF_ROW_HEIGHT}, "Cost-to-Come", TextFormat("%d", std::lround(path_cost_to_come)), COLOR_MINOR_STAT);
     GuiLabelValueColor((Rectangle){STAT_BAR_BUTTON_X_MIN, ROW_4_Y + STAT_BAR_HALF_ROW_HEIGHT, STAT_BAR_BUTTON_WIDTH, STAT_BAR_HALF_ROW_HEIGHT}, "Cost-to-Go", TextFormat("%d", std::lround(path_cost_to_go)), COLOR_MINOR_STAT);
 
+    // Informed set
+    GuiSetStyle(DEFAULT, TEXT_SIZE, SMALL_TEXT_HEIGHT);
+    const float informed_coverage = planner.informedSet(ctrl_state.informed_sampling_enabled).coverage();
+    GuiLabelValueColor((Rectangle){STAT_BAR_BUTTON_X_MIN, ROW_5_Y, STAT_BAR_BUTTON_WIDTH, STAT_BAR_HALF_ROW_HEIGHT}, "Informed", TextFormat("%.1f%%", 100.0f * informed_coverage), COLOR_MINOR_STAT);
+
     // Node counts
     GuiSetStyle(DEFAULT, TEXT_SIZE, BIG_TEXT_HEIGHT);
-    GuiLabelValueColor((Rectangle){STAT_BAR_BUTTON_X_MIN, ROW_6_Y, STAT_BAR_BUTTON_WIDTH, STAT_BAR_ROW_HEIGHT}, "Nodes", TextFormat("%d", planner.tree.nodes.size()), COLOR_STAT);
+    GuiLabelValueColor((Rectangle){STAT_BAR_BUTTON_X_MIN, ROW_6_Y, STAT_BAR_BUTTON_WIDTH, STAT_BAR_ROW_HEIGHT}, "Nodes", TextFormat("%d", planner.nodes().size()), COLOR_STAT);
 
     GuiSetStyle(DEFAULT, TEXT_SIZE, SMALL_TEXT_HEIGHT);
     GuiLabelValueColor((Rectangle){STAT_BAR_BUTTON_X_MIN, ROW_7_Y, STAT_BAR_BUTTON_WIDTH, STAT_BAR_HALF_ROW_HEIGHT}, "Path", TextFormat("%d", planner.path.size()), COLOR_MINOR_STAT);
@@ -60,8 +67,8 @@ void DrawStatBar(const Problem& problem, const Planner& planner, const Vector2 b
     // TODO factor this out to a tree stats struct and compute just once, pass to tree draw func.
     int num_nodes_lo_cost = 0;
     int num_nodes_hi_cost = 0;
-    for (const NodePtr& node : planner.tree.nodes) {
-        const float cost = node->estimateCostTo(problem.goal);
+    for (const NodeId node : planner.nodes()) {
+        const float cost = pool.estimateCostTo(node, path_target);
         if (cost < path_cost) {
             num_nodes_lo_cost++;
         } else {
@@ -71,6 +78,7 @@ void DrawStatBar(const Problem& problem, const Planner& planner, const Vector2 b
 
     GuiLabelValueColor((Rectangle){STAT_BAR_BUTTON_X_MIN, ROW_7_Y + STAT_BAR_HALF_ROW_HEIGHT, STAT_BAR_BUTTON_WIDTH, STAT_BAR_HALF_ROW_HEIGHT}, "Low Cost", TextFormat("%d", num_nodes_lo_cost), COLOR_MINOR_STAT);
     GuiLabelValueColor((Rectangle){STAT_BAR_BUTTON_X_MIN, ROW_8_Y, STAT_BAR_BUTTON_WIDTH, STAT_BAR_HALF_ROW_HEIGHT}, "High Cost", TextFormat("%d", num_nodes_hi_cost), COLOR_MINOR_STAT);
+    GuiLabelValueColor((Rectangle){STAT_BAR_BUTTON_X_MIN, ROW_8_Y + STAT_BAR_HALF_ROW_HEIGHT, STAT_BAR_BUTTON_WIDTH, STAT_BAR_HALF_ROW_HEIGHT}, "Neighbors", TextFormat("%.1f", planner.meanNeighborhoodSize()), COLOR_MINOR_STAT);
 
     // Env info
     GuiSetStyle(DEFAULT, TEXT_SIZE, BIG_TEXT_HEIGHT);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cmath>
+
 #include <raylib.h>
 
 #include "planner/cost.h"
@@ -13,10 +15,14 @@ float computeLineWidth(const int tree_size) {
     return Remap(1.0f / n, TREE_SIZE_INV_MIN, TREE_SIZE_INV_MAX, LINE_WIDTH_TREE_MIN, LINE_WIDTH_TREE_MAX);
 }
 
-float computeMaxCost(Nodes nodes, const Vector2 goal) {
+// Nodes not yet connected to the root have infinite cost and are left out.
+float computeMaxCost(const NodePool& pool, const NodeIds& nodes, const Vector2 goal) {
     float cost_max = 0.0f;
-    for (const NodePtr& node : nodes) {
-        cost_max = std::max(cost_max, node->estimateCostTo(goal));
+    for (const NodeId node : nodes) {
+        const float cost = pool.estimateCostTo(node, goal);
+        if (std::isfinite(cost)) {
+            cost_max = std::max(cost_max, cost);
+        }
     }
     return cost_max;
 }
@@ -48,25 +54,25 @@ Color computeCostColor(const float x, const bool goal_reached) {
     return guppyColor(y);
 }
 
-void DrawTree(const Tree& tree, const Path& path, const Vector2 goal, const bool goal_reached) {
-    const NodePtr root = tree.nodes.front();
-    const float cost_root = root->estimateCostTo(goal);
-    const float cost_path = computeMaxCost(path, goal);
-    const float cost_tree = computeMaxCost(tree.nodes, goal);
+// Colors each edge by the estimated cost of a path through it, from the root toward the goal.
+void DrawTree(const NodePool& pool, const NodeIds& nodes, const NodeId root, const Path& path, const Vector2 goal, const bool goal_reached) {
+    const float cost_root = pool.estimateCostTo(root, goal);
+    const float cost_path = computeMaxCost(pool, path, goal);
+    const float cost_tree = computeMaxCost(pool, nodes, goal);
 
     // Sort by heuristic cost.
-    Nodes sorted_nodes = tree.nodes;
-    std::sort(sorted_nodes.begin(), sorted_nodes.end(), TargetCostComparatorInv{goal});
+    NodeIds sorted_nodes = nodes;
+    std::sort(sorted_nodes.begin(), sorted_nodes.end(), TargetCostComparatorInv{pool, goal});
 
     // Draw in sorted order.
-    const float line_width = computeLineWidth(tree.nodes.size());
-    for (const NodePtr& node : sorted_nodes) {
-        if (!node->parent) {
+    const float line_width = computeLineWidth(nodes.size());
+    for (const NodeId node : sorted_nodes) {
+        if (!pool.hasParent(node)) {
             continue;
         }
-        const float cost = node->estimateCostTo(goal);
+        const float cost = pool.estimateCostTo(node, goal);
         const float cost_normalized = normalizeCost(cost, cost_root, cost_path, cost_tree);
         const Color color = computeCostColor(cost_normalized, goal_reached);
-        DrawLineEx(node->parent->pos, node->pos, line_width, color);
+        DrawLineEx(pool.pos[pool.parent[node]], pool.pos[node], line_width, color);
     }
 }
\ No newline at end of file